@@ -0,0 +1 @@
+#include "../../../src/private/busyindicator_p.hpp"
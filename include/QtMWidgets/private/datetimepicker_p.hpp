@@ -0,0 +1 @@
+#include "../../../src/private/datetimepicker_p.hpp"
@@ -0,0 +1 @@
+#include "../../../src/private/picker_p.hpp"
@@ -0,0 +1 @@
+#include "../../../src/private/textlabel_p.hpp"
@@ -0,0 +1 @@
+#include "../../../src/private/utils.hpp"
@@ -12,12 +12,12 @@
 #include "private/abstractscrollarea_p.hpp"
 #include "listmodel.hpp"
 #include "fingergeometry.hpp"
+#include "virtualclock.hpp"
+#include "private/animationtimer.hpp"
 
 // Qt include.
 #include <QWidget>
 #include <QMouseEvent>
-#include <QTimer>
-#include <QElapsedTimer>
 #include <QPainter>
 
 
@@ -84,9 +84,9 @@ public:
 	//! Click count;
 	int clickCount;
 	//! Timer.
-	QTimer * timer;
+	AnimationTimer * timer;
 	//! Elapsed timer.
-	QElapsedTimer elapsedTimer;
+	ElapsedTimer elapsedTimer;
 }; // class AbstractListViewPrivate
 
 
@@ -908,11 +908,12 @@ AbstractListViewPrivate< T >::init()
 	Private::Viewport< T > * viewport = new Private::Viewport< T >( q );
 	viewport->setData( this );
 
-	timer = new QTimer( q );
+	timer = new AnimationTimer( q );
+	timer->setSingleShot( true );
 
 	q->setViewport( viewport );
 
-	QObject::connect( timer, &QTimer::timeout,
+	QObject::connect( timer, &AnimationTimer::timeout,
 		q, &AbstractListView< T >::timerElapsed );
 }
 
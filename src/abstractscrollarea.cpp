@@ -7,6 +7,8 @@
 // QtMWidgets include.
 #include "abstractscrollarea.hpp"
 #include "private/abstractscrollarea_p.hpp"
+#include "private/movecoalescer.hpp"
+#include "private/animationtimer.hpp"
 #include "scroller.hpp"
 #include "fingergeometry.hpp"
 
@@ -16,7 +18,6 @@
 #include <QMouseEvent>
 #include <QResizeEvent>
 #include <QWheelEvent>
-#include <QTimer>
 #include <QLinearGradient>
 #include <QVariantAnimation>
 
@@ -222,14 +223,16 @@ AbstractScrollAreaPrivate::init()
 	vertBlurAnim->setDuration( 300 );
 	vertBlurAnim->setLoopCount( 1 );
 
-	animationTimer = new QTimer( q );
+	animationTimer = new AnimationTimer( q );
 	animationTimer->setSingleShot( true );
 
-	startBlurAnimTimer = new QTimer( q );
+	startBlurAnimTimer = new AnimationTimer( q );
 	startBlurAnimTimer->setSingleShot( true );
 
 	scroller = new Scroller( q, q );
 
+	moveCoalescer = new MoveCoalescer( q );
+
 	q->setFocusPolicy( Qt::WheelFocus );
 	q->setFrameStyle( QFrame::NoFrame | QFrame::Plain );
 	q->setSizePolicy( QSizePolicy::Expanding, QSizePolicy::Expanding );
@@ -610,10 +613,10 @@ AbstractScrollArea::AbstractScrollArea( QWidget * parent )
 {
 	d->init();
 
-	connect( d->animationTimer, &QTimer::timeout,
+	connect( d->animationTimer, &AnimationTimer::timeout,
 		this, &AbstractScrollArea::_q_animateScrollIndicators );
 
-	connect( d->startBlurAnimTimer, &QTimer::timeout,
+	connect( d->startBlurAnimTimer, &AnimationTimer::timeout,
 		this, &AbstractScrollArea::_q_startBlurAnim );
 
 	connect( d->scroller, &Scroller::scroll,
@@ -636,6 +639,9 @@ AbstractScrollArea::AbstractScrollArea( QWidget * parent )
 
 	connect( d->vertBlurAnim, &QVariantAnimation::finished,
 		this, &AbstractScrollArea::_q_vertBlurAnimFinished );
+
+	connect( d->moveCoalescer, &MoveCoalescer::moved,
+		this, &AbstractScrollArea::_q_coalescedMove );
 }
 
 AbstractScrollArea::AbstractScrollArea( AbstractScrollAreaPrivate * dd,
@@ -645,10 +651,10 @@ AbstractScrollArea::AbstractScrollArea( AbstractScrollAreaPrivate * dd,
 {
 	d->init();
 
-	connect( d->animationTimer, &QTimer::timeout,
+	connect( d->animationTimer, &AnimationTimer::timeout,
 		this, &AbstractScrollArea::_q_animateScrollIndicators );
 
-	connect( d->startBlurAnimTimer, &QTimer::timeout,
+	connect( d->startBlurAnimTimer, &AnimationTimer::timeout,
 		this, &AbstractScrollArea::_q_startBlurAnim );
 
 	connect( d->scroller, &Scroller::scroll,
@@ -671,6 +677,9 @@ AbstractScrollArea::AbstractScrollArea( AbstractScrollAreaPrivate * dd,
 
 	connect( d->vertBlurAnim, &QVariantAnimation::finished,
 		this, &AbstractScrollArea::_q_vertBlurAnimFinished );
+
+	connect( d->moveCoalescer, &MoveCoalescer::moved,
+		this, &AbstractScrollArea::_q_coalescedMove );
 }
 
 AbstractScrollArea::~AbstractScrollArea()
@@ -930,6 +939,7 @@ AbstractScrollArea::mousePressEvent( QMouseEvent * e )
 	{
 		d->mousePos = e->pos();
 		d->leftMouseButtonPressed = true;
+		d->moveCoalescer->reset();
 		d->stopScrollIndicatorsAnimation();
 
 		e->accept();
@@ -945,6 +955,8 @@ AbstractScrollArea::mouseReleaseEvent( QMouseEvent * e )
 	{
 		d->leftMouseButtonPressed = false;
 
+		d->moveCoalescer->flush();
+
 		if( ( d->horIndicator->needPaint || d->vertIndicator->needPaint ) &&
 			( d->horIndicator->policy == ScrollIndicatorAsNeeded ||
 				d->vertIndicator->policy == ScrollIndicatorAsNeeded ) )
@@ -970,9 +982,7 @@ AbstractScrollArea::mouseMoveEvent( QMouseEvent * e )
 
 		d->mousePos = e->pos();
 
-		d->scrollContentsBy( dx, dy );
-
-		scrollContentsBy( dx, dy );
+		d->moveCoalescer->addMove( QPoint( dx, dy ) );
 
 		e->accept();
 	}
@@ -1053,6 +1063,7 @@ AbstractScrollArea::_q_kineticScrolling( int dx, int dy )
 void
 AbstractScrollArea::_q_kineticScrollingAboutToStart()
 {
+	d->moveCoalescer->flush();
 	d->stopScrollIndicatorsAnimation();
 	d->stopAnimatingBlurEffect();
 }
@@ -1102,4 +1113,11 @@ AbstractScrollArea::_q_startBlurAnim()
 	d->animateHiddingBlurEffect();
 }
 
+void
+AbstractScrollArea::_q_coalescedMove( const QPoint & delta )
+{
+	d->scrollContentsBy( delta.x(), delta.y() );
+	scrollContentsBy( delta.x(), delta.y() );
+}
+
 } /* namespace QtMWidgets */
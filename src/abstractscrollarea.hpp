@@ -244,6 +244,7 @@ private slots:
 	void _q_vertBlurAnim( const QVariant & value );
 	void _q_vertBlurAnimFinished();
 	void _q_startBlurAnim();
+	void _q_coalescedMove( const QPoint & delta );
 
 private:
 	Q_DISABLE_COPY( AbstractScrollArea )
@@ -6,41 +6,157 @@
 
 // QtMWidgets include.
 #include "busyindicator.hpp"
+#include "private/busyindicator_p.hpp"
 
 // Qt include.
 #include <QPainter>
 #include <QVariantAnimation>
 #include <QPainterPath>
+#include <QHash>
+#include <QCoreApplication>
 
 
 namespace QtMWidgets {
 
+//! Count of prerendered frames for the full turn.
+static const int framesCount = 60;
+
+//! Maximum number of cached sets of frames.
+static const int maxCachedFrames = 16;
+
+
 //
-// BusyIndicatorPrivate
+// paintRing
+//
+
+//! Paint ring rotated on \a angle degrees around the painter's origin.
+static void
+paintRing( QPainter * p, int outerRadius, int innerRadius,
+	const QColor & color, qreal angle )
+{
+	QPainterPath path;
+	path.setFillRule( Qt::OddEvenFill );
+	path.addEllipse( - outerRadius, - outerRadius,
+		outerRadius * 2, outerRadius * 2 );
+	path.addEllipse( - innerRadius, - innerRadius,
+		innerRadius * 2, innerRadius * 2 );
+
+	p->setPen( Qt::NoPen );
+
+	QConicalGradient gradient( 0, 0, - angle );
+	gradient.setColorAt( 0.0, Qt::transparent );
+	gradient.setColorAt( 0.05, color );
+	gradient.setColorAt( 1.0, Qt::transparent );
+
+	p->setBrush( gradient );
+
+	p->drawPath( path );
+}
+
+
+//
+// framesCache
 //
 
-class BusyIndicatorPrivate {
-public:
-	BusyIndicatorPrivate( BusyIndicator * parent )
-		:	q( parent )
-		,	outerRadius( 10 )
-		,	innerRadius( outerRadius * 0.6 )
-		,	size( outerRadius * 2, outerRadius * 2 )
-		,	running( true )
-		,	animation( 0 )
+typedef QHash< QString, QSharedPointer< BusyIndicatorFrames > > FramesCache;
+
+//! Is cleanup of the cache of frames registered?
+static bool framesCleanupAdded = false;
+
+//! \return Cache of frames.
+static FramesCache &
+framesCache()
+{
+	static FramesCache cache;
+
+	return cache;
+}
+
+//! Free cached frames, called when the application is destroyed.
+static void
+clearFramesCache()
+{
+	framesCache().clear();
+	framesCleanupAdded = false;
+}
+
+
+//
+// BusyIndicatorFrames
+//
+
+BusyIndicatorFrames::BusyIndicatorFrames( int outer, int inner,
+	const QColor & c, qreal r )
+	:	outerRadius( outer )
+	,	innerRadius( inner )
+	,	color( c )
+	,	dpr( r )
+	,	frames( framesCount )
+{
+}
+
+const QPixmap &
+BusyIndicatorFrames::frame( qreal angle )
+{
+	const int i = qRound( angle * framesCount / 360.0 ) % framesCount;
+
+	QPixmap & pixmap = frames[ i ];
+
+	if( pixmap.isNull() )
+	{
+		pixmap = QPixmap( QSize( outerRadius * 2, outerRadius * 2 ) * dpr );
+		pixmap.setDevicePixelRatio( dpr );
+		pixmap.fill( Qt::transparent );
+
+		QPainter p( &pixmap );
+		p.setRenderHint( QPainter::Antialiasing );
+		p.translate( outerRadius, outerRadius );
+
+		paintRing( &p, outerRadius, innerRadius, color,
+			360.0 * i / framesCount );
+	}
+
+	return pixmap;
+}
+
+QSharedPointer< BusyIndicatorFrames >
+BusyIndicatorFrames::get( int outerRadius, int innerRadius,
+	const QColor & color, qreal dpr )
+{
+	FramesCache & cache = framesCache();
+
+	// Pixmaps must not outlive the application.
+	if( !framesCleanupAdded )
 	{
+		qAddPostRoutine( clearFramesCache );
+		framesCleanupAdded = true;
 	}
 
-	void init();
+	const QString key = QStringLiteral( "%1-%2-%3" ).arg( outerRadius )
+		.arg( color.rgba() ).arg( qRound( dpr * 100 ) );
+
+	auto it = cache.constFind( key );
+
+	if( it != cache.cend() )
+		return it.value();
+
+	// Running indicators hold their frames, after dropping the cache
+	// new indicators of the same look render frames again.
+	if( cache.size() >= maxCachedFrames )
+		cache.clear();
+
+	QSharedPointer< BusyIndicatorFrames > frames(
+		new BusyIndicatorFrames( outerRadius, innerRadius, color, dpr ) );
+
+	cache.insert( key, frames );
+
+	return frames;
+}
+
 
-	BusyIndicator * q;
-	int outerRadius;
-	int innerRadius;
-	QSize size;
-	bool running;
-	QVariantAnimation * animation;
-	QColor color;
-}; // class BusyIndicatorPrivate
+//
+// BusyIndicatorPrivate
+//
 
 void
 BusyIndicatorPrivate::init()
@@ -59,6 +175,18 @@ BusyIndicatorPrivate::init()
 	animation->start();
 }
 
+BusyIndicatorFrames *
+BusyIndicatorPrivate::currentFrames()
+{
+	const qreal dpr = q->devicePixelRatioF();
+
+	if( !frames || !frames->isFor( outerRadius, color, dpr ) )
+		frames = BusyIndicatorFrames::get( outerRadius, innerRadius,
+			color, dpr );
+
+	return frames.data();
+}
+
 
 //
 // BusyIndicator
@@ -137,6 +265,26 @@ BusyIndicator::setRadius( int r )
 	}
 }
 
+bool
+BusyIndicator::isPrerendered() const
+{
+	return d->prerendered;
+}
+
+void
+BusyIndicator::setPrerendered( bool on )
+{
+	if( d->prerendered != on )
+	{
+		d->prerendered = on;
+
+		if( !d->prerendered )
+			d->frames.clear();
+
+		update();
+	}
+}
+
 QSize
 BusyIndicator::minimumSizeHint() const
 {
@@ -153,26 +301,22 @@ void
 BusyIndicator::paintEvent( QPaintEvent * )
 {
 	QPainter p( this );
-	p.setRenderHint( QPainter::Antialiasing );
-	p.translate( width() / 2, height() / 2 );
 
-	QPainterPath path;
-	path.setFillRule( Qt::OddEvenFill );
-	path.addEllipse( - d->outerRadius, - d->outerRadius,
-		d->outerRadius * 2, d->outerRadius * 2 );
-	path.addEllipse( - d->innerRadius, - d->innerRadius,
-		d->innerRadius * 2, d->innerRadius * 2 );
-
-	p.setPen( Qt::NoPen );
-
-	QConicalGradient gradient( 0, 0, - d->animation->currentValue().toReal() );
-	gradient.setColorAt( 0.0, Qt::transparent );
-	gradient.setColorAt( 0.05, d->color );
-	gradient.setColorAt( 1.0, Qt::transparent );
+	const qreal angle = d->animation->currentValue().toReal();
 
-	p.setBrush( gradient );
+	if( d->prerendered )
+	{
+		p.drawPixmap( width() / 2 - d->outerRadius,
+			height() / 2 - d->outerRadius,
+			d->currentFrames()->frame( angle ) );
+	}
+	else
+	{
+		p.setRenderHint( QPainter::Antialiasing );
+		p.translate( width() / 2, height() / 2 );
 
-	p.drawPath( path );
+		paintRing( &p, d->outerRadius, d->innerRadius, d->color, angle );
+	}
 }
 
 void
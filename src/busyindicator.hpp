@@ -58,6 +58,19 @@ class BusyIndicator
 		By default, this property is 10.
 	*/
 	Q_PROPERTY( int radius READ radius WRITE setRadius )
+	/*!
+		\property prerendered
+
+		\brief whether frames of the animation are prerendered.
+
+		When this property is true frames are rendered once and
+		shared by all busy indicators with the same radius, color
+		and device pixel ratio, so each animation step is a single
+		pixmap blit.
+
+		By default, this property is true.
+	*/
+	Q_PROPERTY( bool prerendered READ isPrerendered WRITE setPrerendered )
 
 public:
 	BusyIndicator( QWidget * parent = 0 );
@@ -78,6 +91,11 @@ public:
 	//! Set radius.
 	void setRadius( int r );
 
+	//! \return Are frames of the animation prerendered?
+	bool isPrerendered() const;
+	//! Set whether frames of the animation are prerendered.
+	void setPrerendered( bool on );
+
 	QSize minimumSizeHint() const override;
 	QSize sizeHint() const override;
 
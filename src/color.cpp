@@ -11,21 +11,18 @@
 namespace QtMWidgets {
 
 //
-// lighterColor
+// shadeHsv
 //
 
-QColor
-lighterColor( const QColor & c, int b )
+//! \return Color \a hsv shaded with bias \a b in the \a spec.
+static QColor
+shadeHsv( const QColor & hsv, int b, QColor::Spec spec )
 {
-	if( b <= 0 )
-		return c;
-
 	int h = 0;
 	int s = 0;
 	int v = 0;
 	int a = 0;
 
-	QColor hsv = c.toHsv();
 	hsv.getHsv( &h, &s, &v, &a );
 
 	v += b;
@@ -38,10 +35,24 @@ lighterColor( const QColor & c, int b )
 
 		v = 255;
 	}
+	else if( v < 0 )
+		v = 0;
 
-	hsv.setHsv( h, s, v, a );
+	return QColor::fromHsv( h, s, v, a ).convertTo( spec );
+}
+
+
+//
+// lighterColor
+//
+
+QColor
+lighterColor( const QColor & c, int b )
+{
+	if( b <= 0 )
+		return c;
 
-	return hsv.convertTo( c.spec() );
+	return shadeHsv( c.toHsv(), b, c.spec() );
 }
 
 
@@ -55,22 +66,26 @@ darkerColor( const QColor & c, int b )
 	if( b <= 0 )
 		return c;
 
-	int h = 0;
-	int s = 0;
-	int v = 0;
-	int a = 0;
+	return shadeHsv( c.toHsv(), -b, c.spec() );
+}
 
-	QColor hsv = c.toHsv();
-	hsv.getHsv( &h, &s, &v, &a );
 
-	v -= b;
+//
+// shadedColors
+//
 
-	if( v < 0 )
-		v = 0;
+QVector< QColor >
+shadedColors( const QColor & c, const QVector< int > & biases )
+{
+	QVector< QColor > result;
+	result.reserve( biases.size() );
+
+	const QColor hsv = c.toHsv();
 
-	hsv.setHsv( h, s, v, a );
+	for( const int b : biases )
+		result.append( b == 0 ? c : shadeHsv( hsv, b, c.spec() ) );
 
-	return hsv.convertTo( c.spec() );
+	return result;
 }
 
 } /* namespace QtMWidgets */
@@ -9,6 +9,7 @@
 
 // Qt include.
 #include <QColor>
+#include <QVector>
 
 
 namespace QtMWidgets {
@@ -28,6 +29,20 @@ QColor lighterColor( const QColor & c, int b );
 //! \return Darker color with HSV value bias \a b.
 QColor darkerColor( const QColor & c, int b );
 
+
+//
+// shadedColors
+//
+
+/*!
+	\return Shades of the color \a c with HSV value biases \a biases.
+	Positive bias gives lighter color like lighterColor(), negative
+	bias gives darker color like darkerColor().
+
+	Color is converted to HSV once for all shades.
+*/
+QVector< QColor > shadedColors( const QColor & c, const QVector< int > & biases );
+
 } /* namespace QtMWidgets */
 
 #endif // QTMWIDGETS__COLOR_HPP__INCLUDED
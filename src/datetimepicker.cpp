@@ -6,10 +6,9 @@
 
 // QtMWidgets include.
 #include "datetimepicker.hpp"
-#include "private/datetimeparser.hpp"
+#include "private/datetimepicker_p.hpp"
 #include "private/drawing.hpp"
-#include "color.hpp"
-#include "scroller.hpp"
+#include "private/localetables.hpp"
 
 // Qt include.
 #include <QEvent>
@@ -27,77 +26,6 @@ namespace QtMWidgets {
 // DateTimePickerPrivate
 //
 
-class DateTimePickerPrivate
-	:	public DateTimeParser
-{
-public:
-	DateTimePickerPrivate( DateTimePicker * parent,
-		QMetaType::Type parserType )
-		:	DateTimeParser( parserType )
-		,	q( parent )
-		,	minimum( QDateTime( DATETIMEPICKER_COMPAT_DATE_MIN,
-				DATETIMEPICKER_TIME_MIN ) )
-		,	maximum( DATETIMEPICKER_DATETIME_MAX )
-		,	value( QDateTime( DATETIMEPICKER_DATE_INITIAL,
-				DATETIMEPICKER_TIME_MIN ) )
-		,	spec( Qt::LocalTime )
-		,	itemHeight( 0 )
-		,	itemTopMargin( 0 )
-		,	itemsMaxCount( 5 )
-		,	itemSideMargin( 5 )
-		,	widgetHeight( 0 )
-		,	currentItemY( 0 )
-		,	leftMouseButtonPressed( false )
-		,	movableSection( -1 )
-		,	daysSection( -1 )
-		,	monthSection( -1 )
-		,	yearSection( -1 )
-		,	scroller( new Scroller( q, q ) )
-		,	scrolling( false )
-	{
-		initDaysMonthYearSectionIndex();
-		fillValues();
-	}
-
-	void updateTimeSpec();
-	void setRange( const QDateTime & min, const QDateTime & max );
-	void setValue( const QDateTime & dt, bool updateIndexes = true );
-	void emitSignals();
-	void normalizeOffset( int section );
-	void normalizeOffsets();
-	void drawSectionItems( int section, QPainter * p,
-		const QStyleOption & opt );
-	void drawWindow( QPainter * p, const QStyleOption & opt );
-	void findMovableSection( const QPointF & pos );
-	void updateOffset( int delta );
-	void clearOffset();
-	void updateDaysIfNeeded();
-	void updateCurrentDateTime();
-	void initDaysMonthYearSectionIndex();
-	void fillValues( bool updateIndexes = true );
-	void releaseScrolling();
-
-	DateTimePicker * q;
-	QDateTime minimum;
-	QDateTime maximum;
-	QDateTime value;
-	Qt::TimeSpec spec;
-	int itemHeight;
-	int itemTopMargin;
-	int itemsMaxCount; // Must be odd.
-	int itemSideMargin;
-	int widgetHeight;
-	int currentItemY;
-	QPoint mousePos;
-	bool leftMouseButtonPressed;
-	int movableSection;
-	int daysSection;
-	int monthSection;
-	int yearSection;
-	Scroller * scroller;
-	bool scrolling;
-}; // class DateTimePickerPrivate
-
 void
 DateTimePickerPrivate::updateTimeSpec()
 {
@@ -131,6 +59,14 @@ DateTimePickerPrivate::setValue( const QDateTime & dt, bool updateIndexes )
 {
 	if( value != dt )
 	{
+		const QDate oldDate = value.date();
+
+		QVector< int > oldIndexes;
+		oldIndexes.reserve( sections.size() );
+
+		for( int i = 0; i < sections.size(); ++i )
+			oldIndexes.append( sections.at( i ).currentIndex );
+
 		if( dt >= minimum && dt <= maximum )
 			value = dt;
 		else if( dt < minimum )
@@ -138,7 +74,14 @@ DateTimePickerPrivate::setValue( const QDateTime & dt, bool updateIndexes )
 		else if( dt > maximum )
 			value = maximum;
 
-		fillValues( updateIndexes );
+		// Values of the sections depend on the range only,
+		// except days that depend on the month too.
+		bool daysChanged = false;
+
+		if( daysSection != -1 &&
+			( oldDate.year() != value.date().year() ||
+				oldDate.month() != value.date().month() ) )
+					daysChanged = fillSectionValues( daysSection, updateIndexes );
 
 		if( updateIndexes || value != dt )
 		{
@@ -215,6 +158,13 @@ DateTimePickerPrivate::setValue( const QDateTime & dt, bool updateIndexes )
 			}
 		}
 
+		for( int i = 0; i < sections.size(); ++i )
+		{
+			if( sections.at( i ).currentIndex != oldIndexes.at( i ) ||
+				( i == daysSection && daysChanged ) )
+					q->update( sectionRect( i ) );
+		}
+
 		emitSignals();
 	}
 }
@@ -246,7 +196,7 @@ static inline int nextIndex( int current, int size )
 void
 DateTimePickerPrivate::normalizeOffset( int section )
 {
-	const int sectionValuesSize = sections.at( section ).values.size();
+	const int sectionValuesSize = sections.at( section ).valuesCount;
 	const int totalItemHeight = itemHeight + itemTopMargin;
 
 	while( qAbs( sections.at( section ).offset ) > totalItemHeight / 2 )
@@ -268,7 +218,7 @@ DateTimePickerPrivate::normalizeOffset( int section )
 		{
 			if( sectionValuesSize < itemsMaxCount &&
 				sections[ section ].currentIndex ==
-					sections[ section ].values.size() - 1 )
+					sections[ section ].valuesCount - 1 )
 			{
 				sections[ section ].offset = 0;
 				break;
@@ -299,63 +249,110 @@ DateTimePickerPrivate::drawSectionItems( int section, QPainter * p,
 
 	x += 3 + itemSideMargin;
 
-	p->setPen( opt.palette.color( QPalette::WindowText ) );
+	const int size = sections.at( section ).valuesCount;
+
+	if( size == 0 )
+		return;
 
 	const int yOffset = sections.at( section ).offset;
+	const int step = itemHeight + itemTopMargin;
 
 	int makePrevIndexCount = itemsMaxCount / 2;
 
 	if( yOffset > 0 )
 		++makePrevIndexCount;
 
-	if( sections.at( section ).values.size() < itemsMaxCount )
+	if( size < itemsMaxCount )
 		makePrevIndexCount = sections.at( section ).currentIndex;
 
-	int index = sections.at( section ).currentIndex;
-	int y = currentItemY + yOffset;
+	int index = ( sections.at( section ).currentIndex -
+		makePrevIndexCount ) % size;
 
-	for( int i = 0; i < makePrevIndexCount; ++i )
-	{
-		index = prevIndex( index, sections.at( section ).values.size() );
-		y -= ( itemHeight + itemTopMargin );
-	}
+	if( index < 0 )
+		index += size;
+
+	const int y = currentItemY + yOffset - makePrevIndexCount * step;
 
 	int iterationsCount = ( yOffset == 0 ) ? itemsMaxCount : itemsMaxCount + 1;
 
-	if( sections.at( section ).values.size() < itemsMaxCount )
-		iterationsCount = sections.at( section ).values.size();
+	if( size < itemsMaxCount )
+		iterationsCount = size;
 
 	const int textWidth = sections.at( section ).sectionWidth - 6 -
 		itemSideMargin * 2;
 
-	Section::Type type = sections.at( section ).type;
+	if( strips.size() != sections.size() )
+		strips.resize( sections.size() );
+
+	ItemStrip & strip = strips[ section ];
+
+	strip.setGeometry( textWidth, step, q->devicePixelRatioF() );
 
-	for( int i = 0; i < iterationsCount; ++i )
+	int pos = strip.rowPosition( index, iterationsCount, size );
+
+	if( pos < 0 )
 	{
-		const QRect r( x, y, textWidth, itemHeight );
+		// Render items around visible ones, so scrolling by
+		// a few items doesn't need rendering.
+		const int margin = ( size < itemsMaxCount ? 0 : itemsMaxCount );
+		const int count = ( size < itemsMaxCount ? size :
+			itemsMaxCount + 1 + margin * 2 );
 
-		const QString text = sections.at( section ).values.at( index );
+		int first = ( index - margin ) % size;
 
-		if( type == Section::DaySectionShort ||
-			type == Section::DaySectionLong )
-		{
-			QStringList values = text.split( QLatin1Char( ' ' ) );
+		if( first < 0 )
+			first += size;
 
-			p->setPen(
-				lighterColor( opt.palette.color( QPalette::WindowText ), 75 ) );
-			p->drawText( r, Qt::AlignLeft | Qt::TextSingleLine, values.at( 0 ) );
+		strip.render( first, count, size, q->font(),
+			[this, section, textWidth, &opt] ( QPainter * sp, int row, int rowY )
+			{
+				drawSectionItem( section, sp, opt, row,
+					QRect( 0, rowY, textWidth, itemHeight ) );
+			} );
 
-			p->setPen( opt.palette.color( QPalette::WindowText ) );
-			p->drawText( r, Qt::AlignRight | Qt::TextSingleLine, values.at( 1 ) );
-		}
-		else
-			p->drawText( r, Qt::AlignLeft | Qt::TextSingleLine, text );
+		pos = margin;
+	}
+
+	strip.draw( p, x, y, pos );
+}
+
+void
+DateTimePickerPrivate::drawSectionItem( int section, QPainter * p,
+	const QStyleOption & opt, int index, const QRect & r )
+{
+	const QString text = sections.at( section ).label( index );
+
+	const Section::Type type = sections.at( section ).type;
 
-		index = nextIndex( index, sections.at( section ).values.size() );
-		y += itemHeight + itemTopMargin;
+	if( type == Section::DaySectionShort ||
+		type == Section::DaySectionLong )
+	{
+		// Day's value is the name of the day and the number
+		// separated with space.
+		const int space = text.lastIndexOf( QLatin1Char( ' ' ) );
+
+		p->setPen( PaletteColors::cached( colors, opt.palette )
+			.shade( QPalette::WindowText, 75 ) );
+		p->drawText( r, Qt::AlignLeft | Qt::TextSingleLine, text.left( space ) );
+
+		p->setPen( opt.palette.color( QPalette::WindowText ) );
+		p->drawText( r, Qt::AlignRight | Qt::TextSingleLine,
+			text.mid( space + 1 ) );
+	}
+	else
+	{
+		p->setPen( opt.palette.color( QPalette::WindowText ) );
+		p->drawText( r, Qt::AlignLeft | Qt::TextSingleLine, text );
 	}
 }
 
+void
+DateTimePickerPrivate::invalidateStrips()
+{
+	for( int i = 0; i < strips.size(); ++i )
+		strips[ i ].invalidate();
+}
+
 void
 DateTimePickerPrivate::drawWindow( QPainter * p, const QStyleOption & opt )
 {
@@ -369,16 +366,16 @@ DateTimePickerPrivate::drawWindow( QPainter * p, const QStyleOption & opt )
 	int yTop = currentItemY - windowOffset;
 	int yBottom = yTop + windowMiddleHeight * 2;
 
-	const QColor baseColor = q->palette().color( QPalette::Dark );
+	const PaletteColors & shades = PaletteColors::cached( colors, opt.palette );
 
-	QColor c1 = baseColor;
+	QColor c1 = opt.palette.color( QPalette::Dark );
 	c1.setAlpha( alpha2 );
 	p->setPen( c1 );
 
 	p->drawLine( 0, yTop, opt.rect.width(), yTop );
 	p->drawLine( 0, yBottom, opt.rect.width(), yBottom );
 
-	QColor c2 = lighterColor( baseColor, 110 );
+	QColor c2 = shades.shade( QPalette::Dark, 110 );
 	c2.setAlpha( alpha2 );
 	p->setPen( c2 );
 
@@ -387,11 +384,11 @@ DateTimePickerPrivate::drawWindow( QPainter * p, const QStyleOption & opt )
 	QLinearGradient g( QPointF( 0.0, 0.0 ), QPointF( 0.0, 1.0 ) );
 	g.setCoordinateMode( QGradient::ObjectBoundingMode );
 
-	QColor c3 = lighterColor( baseColor, 95 );
+	QColor c3 = shades.shade( QPalette::Dark, 95 );
 	c3.setAlpha( alpha );
 	g.setColorAt( 0.0, c3 );
 
-	QColor c4 = lighterColor( baseColor, 50 );
+	QColor c4 = shades.shade( QPalette::Dark, 50 );
 	c4.setAlpha( alpha );
 	g.setColorAt( 1.0, c4 );
 
@@ -400,7 +397,7 @@ DateTimePickerPrivate::drawWindow( QPainter * p, const QStyleOption & opt )
 
 	p->drawRect( 0, yTop + 2, opt.rect.width(), windowMiddleHeight - 2 );
 
-	QColor c5 = lighterColor( baseColor, 35 );
+	QColor c5 = shades.shade( QPalette::Dark, 35 );
 	c5.setAlpha( alpha );
 	p->setBrush( c5 );
 	p->drawRect( 0, yTop + windowMiddleHeight,
@@ -465,14 +462,15 @@ DateTimePickerPrivate::updateDaysIfNeeded()
 			date.setDate( year, month, 28 );
 			dummy.setDate( date );
 
-			sections[ daysSection ].fillValues( dummy, minimum, maximum,
-				false );
+			if( sections[ daysSection ].fillValues( dummy, minimum, maximum,
+					false ) && daysSection < strips.size() )
+				strips[ daysSection ].invalidate();
 
 			if( sections[ daysSection ].currentIndex >
-				sections[ daysSection ].values.size() - 1 )
+				sections[ daysSection ].valuesCount - 1 )
 			{
 				sections[ daysSection ].currentIndex =
-					sections[ daysSection ].values.size() - 1;
+					sections[ daysSection ].valuesCount - 1;
 			}
 		}
 	}
@@ -595,13 +593,36 @@ void
 DateTimePickerPrivate::fillValues( bool updateIndexes )
 {
 	for( int i = 0; i < sections.size(); ++i )
-	{
-		sections[ i ].fillValues( value, minimum, maximum,
-			updateIndexes );
+		fillSectionValues( i, updateIndexes );
+}
 
-		if( sections.at( i ).currentIndex == -1 )
-			sections[ i ].currentIndex = 0;
-	}
+bool
+DateTimePickerPrivate::fillSectionValues( int section, bool updateIndexes )
+{
+	if( strips.size() != sections.size() )
+		strips.resize( sections.size() );
+
+	const bool changed = sections[ section ].fillValues( value,
+		minimum, maximum, updateIndexes );
+
+	if( changed )
+		strips[ section ].invalidate();
+
+	if( sections.at( section ).currentIndex == -1 )
+		sections[ section ].currentIndex = 0;
+
+	return changed;
+}
+
+QRect
+DateTimePickerPrivate::sectionRect( int section ) const
+{
+	int x = 0;
+
+	for( int i = 0; i < section; ++i )
+		x += sections.at( i ).sectionWidth;
+
+	return QRect( x, 0, sections.at( section ).sectionWidth, widgetHeight );
 }
 
 void
@@ -921,6 +942,7 @@ DateTimePicker::setFormat( const QString & format )
 {
 	if( d->parseFormat( format ) )
 	{
+		d->strips.clear();
 		d->initDaysMonthYearSectionIndex();
 		d->fillValues();
 		updateGeometry();
@@ -970,7 +992,7 @@ DateTimePicker::sizeHint() const
 
 	for( int i = 0; i < d->sections.size(); ++i )
 	{
-		d->sections[ i ].sectionWidth = d->sections.at( i ).maxWidth( opt );
+		d->sections[ i ].sectionWidth = d->sections.at( i ).maxWidth( font() );
 		d->sections[ i ].sectionWidth += d->itemSideMargin * 2 + 6;
 		widgetWidth += d->sections[ i ].sectionWidth;
 	}
@@ -1076,7 +1098,45 @@ DateTimePicker::mouseReleaseEvent( QMouseEvent * event )
 }
 
 void
-DateTimePicker::paintEvent( QPaintEvent * )
+DateTimePicker::changeEvent( QEvent * event )
+{
+	switch( event->type() )
+	{
+		case QEvent::FontChange :
+			d->invalidateStrips();
+		break;
+
+		case QEvent::PaletteChange :
+		case QEvent::EnabledChange :
+		case QEvent::ActivationChange :
+		case QEvent::StyleChange :
+			d->colors.clear();
+			d->invalidateStrips();
+		break;
+
+		case QEvent::LocaleChange :
+		{
+			LocaleTables::updateSystem();
+
+			for( int i = 0; i < d->sections.size(); ++i )
+				d->sections[ i ].labels.clear();
+
+			d->invalidateStrips();
+
+			updateGeometry();
+			update();
+		}
+		break;
+
+		default :
+			break;
+	}
+
+	QWidget::changeEvent( event );
+}
+
+void
+DateTimePicker::paintEvent( QPaintEvent * event )
 {
 	d->normalizeOffsets();
 
@@ -1091,12 +1151,16 @@ DateTimePicker::paintEvent( QPaintEvent * )
 	{
 		const QRect r( x, 0, d->sections.at( i ).sectionWidth, d->widgetHeight );
 
+		x += d->sections.at( i ).sectionWidth;
+
+		// Only changed sections are updated by setValue().
+		if( !r.intersects( event->rect() ) )
+			continue;
+
 		drawCylinder( &p, r, palette().color( QPalette::Dark ),
 			( i == 0 ), ( i == d->sections.size() - 1 ) );
 
 		d->drawSectionItems( i, &p, opt );
-
-		x += d->sections.at( i ).sectionWidth;
 	}
 
 	d->drawWindow( &p, opt );
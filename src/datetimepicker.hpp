@@ -476,6 +476,7 @@ protected:
 	void mousePressEvent( QMouseEvent * event ) override;
 	void mouseMoveEvent( QMouseEvent * event ) override;
 	void mouseReleaseEvent( QMouseEvent * event ) override;
+	void changeEvent( QEvent * event ) override;
 	void paintEvent( QPaintEvent * event ) override;
 
 	DateTimePicker( const QVariant & val, QMetaType::Type parserType,
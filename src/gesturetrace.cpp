@@ -0,0 +1,393 @@
+
+/*
+	SPDX-FileCopyrightText: 2014-2024 Igor Mironchik <igor.mironchik@gmail.com>
+	SPDX-License-Identifier: MIT
+*/
+
+// QtMWidgets include.
+#include "gesturetrace.hpp"
+#include "virtualclock.hpp"
+
+// Qt include.
+#include <QWidget>
+#include <QPointer>
+#include <QMouseEvent>
+#include <QDataStream>
+#include <QCoreApplication>
+#include <QElapsedTimer>
+#include <QImage>
+
+
+namespace QtMWidgets {
+
+//
+// GestureEvent
+//
+
+GestureEvent::GestureEvent()
+	:	type( QEvent::None )
+	,	time( 0 )
+{
+}
+
+GestureEvent::GestureEvent( QEvent::Type t, const QPoint & p, qint64 tm )
+	:	type( t )
+	,	pos( p )
+	,	time( tm )
+{
+}
+
+QDataStream &
+operator << ( QDataStream & s, const GestureEvent & e )
+{
+	s << (qint32) e.type << e.pos << e.time;
+
+	return s;
+}
+
+QDataStream &
+operator >> ( QDataStream & s, GestureEvent & e )
+{
+	qint32 type = 0;
+
+	s >> type >> e.pos >> e.time;
+
+	e.type = static_cast< QEvent::Type > ( type );
+
+	return s;
+}
+
+
+//
+// GestureRecorderPrivate
+//
+
+class GestureRecorderPrivate {
+public:
+	explicit GestureRecorderPrivate( QWidget * t )
+		:	target( t )
+		,	recording( false )
+	{
+	}
+
+	//! Target.
+	QPointer< QWidget > target;
+	//! Is recording?
+	bool recording;
+	//! Recorded trace.
+	GestureTrace trace;
+	//! Timer.
+	ElapsedTimer timer;
+}; // class GestureRecorderPrivate
+
+
+//
+// GestureRecorder
+//
+
+GestureRecorder::GestureRecorder( QWidget * target, QObject * parent )
+	:	QObject( parent )
+	,	d( new GestureRecorderPrivate( target ) )
+{
+}
+
+GestureRecorder::~GestureRecorder()
+{
+	stop();
+}
+
+bool
+GestureRecorder::isRecording() const
+{
+	return d->recording;
+}
+
+const GestureTrace &
+GestureRecorder::trace() const
+{
+	return d->trace;
+}
+
+void
+GestureRecorder::start()
+{
+	if( d->recording || !d->target )
+		return;
+
+	d->trace.clear();
+	d->recording = true;
+	d->timer.start();
+
+	d->target->installEventFilter( this );
+}
+
+void
+GestureRecorder::stop()
+{
+	if( !d->recording )
+		return;
+
+	d->recording = false;
+
+	if( d->target )
+		d->target->removeEventFilter( this );
+}
+
+bool
+GestureRecorder::eventFilter( QObject * obj, QEvent * event )
+{
+	if( obj == d->target )
+	{
+		switch( event->type() )
+		{
+			case QEvent::MouseButtonPress :
+			case QEvent::MouseButtonRelease :
+			{
+				QMouseEvent * e = static_cast< QMouseEvent* > ( event );
+
+				if( e->button() == Qt::LeftButton )
+					d->trace.append( GestureEvent( event->type(),
+						e->position().toPoint(), d->timer.elapsed() ) );
+			}
+			break;
+
+			case QEvent::MouseMove :
+			{
+				QMouseEvent * e = static_cast< QMouseEvent* > ( event );
+
+				if( e->buttons() & Qt::LeftButton )
+					d->trace.append( GestureEvent( event->type(),
+						e->position().toPoint(), d->timer.elapsed() ) );
+			}
+			break;
+
+			default :
+				break;
+		}
+
+		return false;
+	}
+	else
+		return QObject::eventFilter( obj, event );
+}
+
+
+//
+// GestureReplayResult
+//
+
+GestureReplayResult::GestureReplayResult()
+	:	frames( 0 )
+	,	droppedFrames( 0 )
+{
+}
+
+qint64
+GestureReplayResult::averagePaintTime() const
+{
+	if( paintTimes.isEmpty() )
+		return 0;
+
+	qint64 sum = 0;
+
+	for( const qint64 t : paintTimes )
+		sum += t;
+
+	return sum / paintTimes.size();
+}
+
+qint64
+GestureReplayResult::maximumPaintTime() const
+{
+	qint64 result = 0;
+
+	for( const qint64 t : paintTimes )
+		result = qMax( result, t );
+
+	return result;
+}
+
+
+//
+// GestureReplayerPrivate
+//
+
+class GestureReplayerPrivate {
+public:
+	explicit GestureReplayerPrivate( QWidget * t )
+		:	target( t )
+		,	frameInterval( 16 )
+		,	maxSettleTime( 5000 )
+	{
+	}
+
+	//! Send event to the target.
+	void sendEvent( const GestureEvent & e, qint64 timestamp );
+	//! Render frame. \return Paint time in nanoseconds.
+	qint64 renderFrame( QImage & image );
+
+	//! Target.
+	QPointer< QWidget > target;
+	//! Frame interval.
+	int frameInterval;
+	//! Maximum settle time.
+	int maxSettleTime;
+}; // class GestureReplayerPrivate
+
+void
+GestureReplayerPrivate::sendEvent( const GestureEvent & e, qint64 timestamp )
+{
+	Qt::MouseButton button = Qt::NoButton;
+	Qt::MouseButtons buttons = Qt::NoButton;
+
+	switch( e.type )
+	{
+		case QEvent::MouseButtonPress :
+			button = Qt::LeftButton;
+			buttons = Qt::LeftButton;
+		break;
+
+		case QEvent::MouseMove :
+			buttons = Qt::LeftButton;
+		break;
+
+		case QEvent::MouseButtonRelease :
+			button = Qt::LeftButton;
+		break;
+
+		default :
+			return;
+	}
+
+	QMouseEvent me( e.type, QPointF( e.pos ),
+		QPointF( target->mapToGlobal( e.pos ) ),
+		button, buttons, Qt::NoModifier );
+	me.setTimestamp( (quint64) timestamp );
+
+	QCoreApplication::sendEvent( target, &me );
+}
+
+qint64
+GestureReplayerPrivate::renderFrame( QImage & image )
+{
+	image.fill( Qt::transparent );
+
+	QElapsedTimer timer;
+	timer.start();
+
+	target->render( &image );
+
+	return timer.nsecsElapsed();
+}
+
+
+//
+// GestureReplayer
+//
+
+GestureReplayer::GestureReplayer( QWidget * target )
+	:	d( new GestureReplayerPrivate( target ) )
+{
+}
+
+GestureReplayer::~GestureReplayer()
+{
+}
+
+int
+GestureReplayer::frameInterval() const
+{
+	return d->frameInterval;
+}
+
+void
+GestureReplayer::setFrameInterval( int msecs )
+{
+	if( msecs > 0 )
+		d->frameInterval = msecs;
+}
+
+int
+GestureReplayer::maximumSettleTime() const
+{
+	return d->maxSettleTime;
+}
+
+void
+GestureReplayer::setMaximumSettleTime( int msecs )
+{
+	if( msecs >= 0 )
+		d->maxSettleTime = msecs;
+}
+
+GestureReplayResult
+GestureReplayer::replay( const GestureTrace & trace )
+{
+	GestureReplayResult result;
+
+	if( !d->target )
+	{
+		qWarning( "QtMWidgets::GestureReplayer::replay: target was destroyed" );
+
+		return result;
+	}
+
+	const qreal dpr = d->target->devicePixelRatioF();
+
+	QImage image( d->target->size() * dpr,
+		QImage::Format_ARGB32_Premultiplied );
+	image.setDevicePixelRatio( dpr );
+
+	// The first frame delivers pending resize events and warms up
+	// caches, it's not counted.
+	d->renderFrame( image );
+
+	VirtualClock clock;
+	clock.activate();
+
+	const qint64 start = clock.currentTime();
+	const qint64 frameBudget = (qint64) d->frameInterval * 1000000;
+	const qint64 lastEventTime = ( trace.isEmpty() ? 0 : trace.last().time );
+
+	qint64 frameTime = 0;
+	int i = 0;
+
+	while( d->target )
+	{
+		frameTime += d->frameInterval;
+
+		for( ; i < trace.size() && trace.at( i ).time < frameTime; ++i )
+		{
+			clock.setCurrentTime( start + trace.at( i ).time );
+
+			d->sendEvent( trace.at( i ), start + trace.at( i ).time );
+
+			if( !d->target )
+				break;
+		}
+
+		if( !d->target )
+			break;
+
+		clock.advanceBy( (int) ( start + frameTime - clock.currentTime() ) );
+
+		const qint64 paintTime = d->renderFrame( image );
+
+		++result.frames;
+		result.paintTimes.append( paintTime );
+
+		if( paintTime > frameBudget )
+			++result.droppedFrames;
+
+		if( i == trace.size() &&
+			( !clock.isRunning() ||
+				frameTime - lastEventTime >= d->maxSettleTime ) )
+					break;
+	}
+
+	clock.deactivate();
+
+	return result;
+}
+
+} /* namespace QtMWidgets */
@@ -0,0 +1,165 @@
+
+/*
+	SPDX-FileCopyrightText: 2014-2024 Igor Mironchik <igor.mironchik@gmail.com>
+	SPDX-License-Identifier: MIT
+*/
+
+#ifndef QTMWIDGETS__GESTURETRACE_HPP__INCLUDED
+#define QTMWIDGETS__GESTURETRACE_HPP__INCLUDED
+
+// Qt include.
+#include <QObject>
+#include <QScopedPointer>
+#include <QEvent>
+#include <QPoint>
+#include <QVector>
+
+QT_BEGIN_NAMESPACE
+class QWidget;
+class QDataStream;
+QT_END_NAMESPACE
+
+
+namespace QtMWidgets {
+
+//
+// GestureEvent
+//
+
+//! One mouse event of the recorded gesture.
+class GestureEvent {
+public:
+	GestureEvent();
+	GestureEvent( QEvent::Type type, const QPoint & pos, qint64 time );
+
+	//! Type of the event: press, move or release of the left button.
+	QEvent::Type type;
+	//! Position of the event in the target's coordinates.
+	QPoint pos;
+	//! Time of the event in milliseconds since the start of recording.
+	qint64 time;
+}; // class GestureEvent
+
+//! Recorded gesture.
+typedef QVector< GestureEvent > GestureTrace;
+
+//! Write gesture event to the stream.
+QDataStream & operator << ( QDataStream & s, const GestureEvent & e );
+//! Read gesture event from the stream.
+QDataStream & operator >> ( QDataStream & s, GestureEvent & e );
+
+
+//
+// GestureRecorder
+//
+
+class GestureRecorderPrivate;
+
+/*!
+	GestureRecorder records press, move and release events of the
+	left mouse button delivered to the target widget together with
+	their timestamps. Recorded trace can be saved and replayed
+	with GestureReplayer against any widget, for example to measure
+	performance of kinetic scrolling.
+*/
+class GestureRecorder
+	:	public QObject
+{
+	Q_OBJECT
+
+public:
+	explicit GestureRecorder( QWidget * target, QObject * parent = 0 );
+	virtual ~GestureRecorder();
+
+	//! \return Is recording in progress?
+	bool isRecording() const;
+
+	//! \return Recorded trace.
+	const GestureTrace & trace() const;
+
+public slots:
+	//! Start recording. Previously recorded trace is cleared.
+	void start();
+	//! Stop recording.
+	void stop();
+
+protected:
+	bool eventFilter( QObject * obj, QEvent * event ) override;
+
+private:
+	Q_DISABLE_COPY( GestureRecorder )
+
+	QScopedPointer< GestureRecorderPrivate > d;
+}; // class GestureRecorder
+
+
+//
+// GestureReplayResult
+//
+
+//! Statistics of the replayed gesture.
+class GestureReplayResult {
+public:
+	GestureReplayResult();
+
+	//! \return Average paint time of the frame in nanoseconds.
+	qint64 averagePaintTime() const;
+	//! \return Maximum paint time of the frame in nanoseconds.
+	qint64 maximumPaintTime() const;
+
+	//! Count of produced frames.
+	int frames;
+	//! Count of frames which painting took longer than frame interval.
+	int droppedFrames;
+	//! Paint time of each frame in nanoseconds.
+	QVector< qint64 > paintTimes;
+}; // class GestureReplayResult
+
+
+//
+// GestureReplayer
+//
+
+class GestureReplayerPrivate;
+
+/*!
+	GestureReplayer sends recorded gesture to the target widget
+	and renders the widget offscreen frame by frame.
+
+	Replaying uses virtual clock: events are delivered at their
+	recorded times, and animations (kinetic scrolling, blur effects,
+	page normalization) are stepped by frame interval, so results
+	don't depend on the speed of the machine. After the last event
+	frames are produced while animations are running, but not longer
+	than maximumSettleTime().
+*/
+class GestureReplayer {
+public:
+	explicit GestureReplayer( QWidget * target );
+	~GestureReplayer();
+
+	//! \return Frame interval in milliseconds. By default is 16 ms.
+	int frameInterval() const;
+	//! Set frame interval in milliseconds.
+	void setFrameInterval( int msecs );
+
+	/*!
+		\return Maximum time in milliseconds to produce frames after the
+		last event of the gesture. By default is 5000 ms.
+	*/
+	int maximumSettleTime() const;
+	//! Set maximum settle time in milliseconds.
+	void setMaximumSettleTime( int msecs );
+
+	//! Replay \a trace. \return Statistics of the produced frames.
+	GestureReplayResult replay( const GestureTrace & trace );
+
+private:
+	Q_DISABLE_COPY( GestureReplayer )
+
+	QScopedPointer< GestureReplayerPrivate > d;
+}; // class GestureReplayer
+
+} /* namespace QtMWidgets */
+
+#endif // QTMWIDGETS__GESTURETRACE_HPP__INCLUDED
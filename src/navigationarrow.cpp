@@ -9,10 +9,10 @@
 #include "fingergeometry.hpp"
 #include "private/drawing.hpp"
 #include "color.hpp"
+#include "private/animationtimer.hpp"
 
 // Qt include.
 #include <QPainter>
-#include <QTimer>
 #include <QMouseEvent>
 
 
@@ -36,9 +36,10 @@ public:
 	{
 		baseColor = q->palette().color( QPalette::Highlight );
 		color = baseColor;
-		timer = new QTimer( q );
+		timer = new AnimationTimer( q );
+		timer->setSingleShot( true );
 
-		QObject::connect( timer, &QTimer::timeout,
+		QObject::connect( timer, &AnimationTimer::timeout,
 			q, &NavigationArrow::_q_timer );
 
 		q->setSizePolicy( QSizePolicy::Fixed, QSizePolicy::Fixed );
@@ -52,7 +53,7 @@ public:
 	NavigationArrow::Direction direction;
 	QColor color;
 	QColor baseColor;
-	QTimer * timer;
+	AnimationTimer * timer;
 	bool leftButtonPressed;
 }; // class NavigationArrowPrivate
 
@@ -12,7 +12,6 @@
 #include "private/utils.hpp"
 
 // Qt include.
-#include <QStyleOption>
 #include <QPainter>
 
 
@@ -33,7 +32,7 @@ public:
 
 	void init();
 	QString makeString( const QString & text, const QRect & r,
-		int flags, const QStyleOption & opt );
+		int flags, const QPaintDevice * device );
 
 	NavigationButton * q;
 	NavigationButton::Direction direction;
@@ -57,9 +56,9 @@ NavigationButtonPrivate::init()
 
 QString
 NavigationButtonPrivate::makeString( const QString & text, const QRect & r,
-	int flags, const QStyleOption & opt )
+	int flags, const QPaintDevice * device )
 {
-	auto res = accomodateString( text, r, flags, opt );
+	auto res = accomodateString( text, r, flags, q->font(), device );
 	res.replace( QLatin1String( "&..." ), QLatin1String( "..." ) );
 
 	return res;
@@ -217,10 +216,7 @@ NavigationButton::paintEvent( QPaintEvent * )
 			break;
 	}
 
-	QStyleOption opt;
-	opt.initFrom( this );
-
-	const QString t = d->makeString( text(), textRect, flags, opt );
+	const QString t = d->makeString( text(), textRect, flags, p.device() );
 
 	p.setPen( d->textColor );
 	p.drawText( textRect, flags, t );
@@ -8,6 +8,7 @@
 #include "pageview.hpp"
 #include "pagecontrol.hpp"
 #include "fingergeometry.hpp"
+#include "private/movecoalescer.hpp"
 
 // Qt include.
 #include <QList>
@@ -34,6 +35,7 @@ public:
 		,	pagesOffset( 0 )
 		,	normalizeAnimation( 0 )
 		,	indexAfterNormalizeAnimation( -1 )
+		,	moveCoalescer( 0 )
 	{
 		init();
 	}
@@ -87,6 +89,8 @@ public:
 	QVariantAnimation * normalizeAnimation;
 	//! Index after normalize animation.
 	int indexAfterNormalizeAnimation;
+	//! Coalesces mouse moves into one move per frame.
+	MoveCoalescer * moveCoalescer;
 }; // class PageViewPrivate
 
 void
@@ -103,6 +107,8 @@ PageViewPrivate::init()
 	normalizeAnimation->setDuration( 300 );
 
 	normalizeAnimation->setLoopCount( 1 );
+
+	moveCoalescer = new MoveCoalescer( q );
 }
 
 void
@@ -341,6 +347,9 @@ PageView::PageView( QWidget * parent )
 	connect( d->normalizeAnimation, &QVariantAnimation::finished,
 		this, &PageView::_q_normalizeAnimationFinished );
 
+	connect( d->moveCoalescer, &MoveCoalescer::moved,
+		this, &PageView::_q_coalescedMove );
+
 	d->relayoutChildren( frameRect().adjusted( frameWidth(), frameWidth(),
 		-frameWidth(), -frameWidth() ) );
 
@@ -503,6 +512,8 @@ PageView::mousePressEvent( QMouseEvent * e )
 
 		d->pos = e->pos();
 
+		d->moveCoalescer->reset();
+
 		d->normalizeAnimation->stop();
 	}
 
@@ -518,10 +529,7 @@ PageView::mouseMoveEvent( QMouseEvent * e )
 
 		d->pos = e->pos();
 
-		if( delta > 0 )
-			d->movePageRight( delta );
-		else if( delta < 0 )
-			d->movePageLeft( qAbs( delta ) );
+		d->moveCoalescer->addMove( QPoint( delta, 0 ) );
 	}
 
 	e->ignore();
@@ -534,6 +542,8 @@ PageView::mouseReleaseEvent( QMouseEvent * e )
 	{
 		d->leftButtonPressed = false;
 
+		d->moveCoalescer->flush();
+
 		d->normalizePagePos();
 	}
 
@@ -558,6 +568,15 @@ PageView::_q_normalizePageAnimation( const QVariant & v )
 	d->movePages();
 }
 
+void
+PageView::_q_coalescedMove( const QPoint & delta )
+{
+	if( delta.x() > 0 )
+		d->movePageRight( delta.x() );
+	else if( delta.x() < 0 )
+		d->movePageLeft( qAbs( delta.x() ) );
+}
+
 void
 PageView::_q_normalizeAnimationFinished()
 {
@@ -181,6 +181,7 @@ private slots:
 	void _q_currentIndexChanged( int index, int prev );
 	void _q_normalizePageAnimation( const QVariant & v );
 	void _q_normalizeAnimationFinished();
+	void _q_coalescedMove( const QPoint & delta );
 
 private:
 	Q_DISABLE_COPY( PageView )
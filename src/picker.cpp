@@ -6,8 +6,8 @@
 
 // QtMWidgets include.
 #include "picker.hpp"
+#include "private/picker_p.hpp"
 #include "private/drawing.hpp"
-#include "color.hpp"
 #include "scroller.hpp"
 #include "fingergeometry.hpp"
 #include "private/utils.hpp"
@@ -21,6 +21,14 @@
 #include <QFontMetrics>
 #include <QBrush>
 #include <QPen>
+#include <QMap>
+#include <QApplication>
+#include <QKeyEvent>
+#include <QThreadPool>
+#include <QPromise>
+
+// C++ include.
+#include <memory>
 
 #ifndef QT_NO_ACCESSIBILITY
 #include <QAccessible>
@@ -29,87 +37,31 @@
 
 namespace QtMWidgets {
 
+//! Maximum number of generated items measured for the size hint.
+static const int maxMeasuredGeneratedItems = 100;
+
+//! Minimum number of items to build text index on the thread pool.
+static const int minAsyncTextIndexSize = 1000;
+
+
 //
 // PickerPrivate
 //
 
-class PickerPrivate {
-public:
-	PickerPrivate( Picker * parent )
-		:	q( parent )
-		,	model( 0 )
-		,	modelColumn( 0 )
-		,	drawItemOffset( 0 )
-		,	indexBeforeChange( -1 )
-		,	inserting( false )
-		,	maxCount( INT_MAX )
-		,	minStringLength( 6 )
-		,	maxStringWidth( 25 )
-		,	stringLength( minStringLength )
-		,	itemsCount( 5 )
-		,	itemTopMargin( 7 )
-		,	itemSideMargin( 0 )
-		,	stringHeight( 0 )
-		,	leftMouseButtonPressed( false )
-		,	mouseWasMoved( false )
-		,	wasPainted( false )
-		,	mouseMoveDelta( 0 )
-		,	scroller( 0 )
-	{}
-
-	void init();
-	void setCurrentIndex( const QModelIndex & mi );
-	QString itemText( const QModelIndex & index ) const;
-	QSize minimumSizeHint( const QStyleOption & opt );
-	QSize sizeHint( const QStyleOption & opt );
-	void computeStringWidth();
-	void drawItem( QPainter * p, const QStyleOption & opt, int offset,
-		const QModelIndex & index );
-	void normalizeOffset();
-	void makePrevIndex( QPersistentModelIndex & index );
-	void makeNextIndex( QPersistentModelIndex & index );
-	QString makeString( const QString & text, const QRect & r, int flags,
-		const QStyleOption & opt );
-	void drawTick( const QRect & r, QPainter * p );
-	void setCurrentIndex( const QPoint & pos );
-	QModelIndex indexForPos( const QPoint & pos );
-	void initDrawOffsetForFirstUse();
-	bool isIndexesVisible( const QModelIndex & topLeft,
-		const QModelIndex & bottomRight );
-	bool isRowsVisible( int start, int end );
-
-	Picker * q;
-	QAbstractItemModel * model;
-	int modelColumn;
-	QPersistentModelIndex currentIndex;
-	QPersistentModelIndex root;
-	QPersistentModelIndex topItemIndex;
-	int drawItemOffset;
-	int indexBeforeChange;
-	bool inserting;
-	int maxCount;
-	int minStringLength;
-	int maxStringWidth;
-	int stringLength;
-	int itemsCount;
-	int itemTopMargin;
-	int itemSideMargin;
-	int stringHeight;
-	QPoint mousePos;
-	bool leftMouseButtonPressed;
-	bool mouseWasMoved;
-	bool wasPainted;
-	int mouseMoveDelta;
-	QColor highlightColor;
-	Scroller * scroller;
-}; // class PickerPrivate
-
 void
 PickerPrivate::init()
 {
 	q->setSizePolicy( QSizePolicy( QSizePolicy::Preferred,
 		QSizePolicy::Fixed ) );
 
+	q->setFocusPolicy( Qt::StrongFocus );
+
+	textIndexWatcher = new QFutureWatcher< TextIndex::Entries >( q );
+
+	QObject::connect( textIndexWatcher,
+		&QFutureWatcher< TextIndex::Entries >::finished,
+		q, &Picker::_q_textIndexBuilt );
+
 	q->setModel( new QStandardItemModel( 0, 1, q ) );
 
 	scroller = new Scroller( q, q );
@@ -121,24 +73,448 @@ PickerPrivate::init()
 }
 
 void
-PickerPrivate::setCurrentIndex( const QModelIndex & mi )
+PickerPrivate::connectModel()
+{
+	QObject::connect( model, &QAbstractItemModel::dataChanged,
+		q, &Picker::_q_dataChanged );
+	QObject::connect( model, &QAbstractItemModel::rowsAboutToBeInserted,
+		q, &Picker::_q_updateIndexBeforeChange );
+	QObject::connect( model, &QAbstractItemModel::rowsInserted,
+		q, &Picker::_q_rowsInserted );
+	QObject::connect( model, &QAbstractItemModel::rowsAboutToBeRemoved,
+		q, &Picker::_q_updateIndexBeforeChange );
+	QObject::connect( model, &QAbstractItemModel::rowsRemoved,
+		q, &Picker::_q_rowsRemoved );
+	QObject::connect( model, &QAbstractItemModel::modelAboutToBeReset,
+		q, &Picker::_q_updateIndexBeforeChange );
+	QObject::connect( model, &QAbstractItemModel::modelReset,
+		q, &Picker::_q_modelReset );
+	QObject::connect( model, &QAbstractItemModel::layoutAboutToBeChanged,
+		q, &Picker::_q_storePersistentRows );
+	QObject::connect( model, &QAbstractItemModel::layoutChanged,
+		q, &Picker::_q_restorePersistentRows );
+	QObject::connect( model, &QAbstractItemModel::rowsAboutToBeMoved,
+		q, &Picker::_q_storePersistentRows );
+	QObject::connect( model, &QAbstractItemModel::rowsMoved,
+		q, &Picker::_q_restorePersistentRows );
+}
+
+void
+PickerPrivate::disconnectModel()
+{
+	QObject::disconnect( model, &QAbstractItemModel::dataChanged,
+		q, &Picker::_q_dataChanged );
+	QObject::disconnect( model, &QAbstractItemModel::rowsAboutToBeInserted,
+		q, &Picker::_q_updateIndexBeforeChange );
+	QObject::disconnect( model, &QAbstractItemModel::rowsInserted,
+		q, &Picker::_q_rowsInserted );
+	QObject::disconnect( model, &QAbstractItemModel::rowsAboutToBeRemoved,
+		q, &Picker::_q_updateIndexBeforeChange );
+	QObject::disconnect( model, &QAbstractItemModel::rowsRemoved,
+		q, &Picker::_q_rowsRemoved );
+	QObject::disconnect( model, &QAbstractItemModel::modelAboutToBeReset,
+		q, &Picker::_q_updateIndexBeforeChange );
+	QObject::disconnect( model, &QAbstractItemModel::modelReset,
+		q, &Picker::_q_modelReset );
+	QObject::disconnect( model, &QAbstractItemModel::layoutAboutToBeChanged,
+		q, &Picker::_q_storePersistentRows );
+	QObject::disconnect( model, &QAbstractItemModel::layoutChanged,
+		q, &Picker::_q_restorePersistentRows );
+	QObject::disconnect( model, &QAbstractItemModel::rowsAboutToBeMoved,
+		q, &Picker::_q_storePersistentRows );
+	QObject::disconnect( model, &QAbstractItemModel::rowsMoved,
+		q, &Picker::_q_restorePersistentRows );
+}
+
+void
+PickerPrivate::setGenerator( int count, const Picker::TextGenerator & gen )
+{
+	// Model's changes mean nothing while items are generated.
+	if( !generated )
+		disconnectModel();
+
+	generated = true;
+	generatedCount = qMin( count, maxCount );
+	generator = gen;
+
+	invalidateWidths();
+	rebuildTextIndex();
+	strip.invalidate();
+
+	const bool hadCurrent = ( currentRow != -1 );
+
+	currentRow = -1;
+	topRow = -1;
+	drawItemOffset = 0;
+
+	if( generatedCount > 0 )
+	{
+		topRow = 0;
+		q->setCurrentIndex( 0 );
+	}
+	else
+	{
+		q->update();
+
+		if( hadCurrent )
+			q->_q_emitCurrentIndexChanged();
+	}
+
+	q->updateGeometry();
+}
+
+void
+PickerPrivate::clearGenerator()
+{
+	generated = false;
+	generatedCount = 0;
+	generator = Picker::TextGenerator();
+	rangeMinimum = 0;
+	rangeStep = 0;
+}
+
+int
+PickerPrivate::findGenerated( const QVariant & data, int role,
+	Qt::MatchFlags flags ) const
+{
+	if( role == Qt::UserRole && rangeStep > 0 )
+	{
+		bool ok = false;
+		const qint64 offset = data.toLongLong( &ok ) - rangeMinimum;
+
+		if( !ok || offset < 0 || offset % rangeStep != 0 ||
+			offset / rangeStep >= generatedCount )
+				return -1;
+
+		return (int) ( offset / rangeStep );
+	}
+
+	if( role != Qt::DisplayRole && role != Qt::EditRole )
+		return -1;
+
+	const QString text = data.toString();
+	const Qt::CaseSensitivity cs = ( flags & Qt::MatchCaseSensitive ?
+		Qt::CaseSensitive : Qt::CaseInsensitive );
+
+	for( int row = 0; row < generatedCount; ++row )
+	{
+		const QString itemText = generator( row );
+		bool found = false;
+
+		switch( flags & 0x0F )
+		{
+			case Qt::MatchStartsWith :
+				found = itemText.startsWith( text, cs );
+			break;
+
+			case Qt::MatchEndsWith :
+				found = itemText.endsWith( text, cs );
+			break;
+
+			case Qt::MatchContains :
+				found = itemText.contains( text, cs );
+			break;
+
+			case Qt::MatchFixedString :
+				found = ( itemText.compare( text, cs ) == 0 );
+			break;
+
+			default :
+				found = ( itemText == text );
+			break;
+		}
+
+		if( found )
+			return row;
+	}
+
+	return -1;
+}
+
+void
+PickerPrivate::setCurrentRow( int row )
+{
+	if( row < 0 || row >= q->count() )
+		row = -1;
+
+	if( row != -1 )
+		pendingCurrent = false;
+
+	if( row != currentRow )
+	{
+		currentRow = row;
+		strip.invalidate();
+		q->update();
+		q->_q_emitCurrentIndexChanged();
+	}
+}
+
+QModelIndex
+PickerPrivate::indexForRow( int row ) const
+{
+	return model->index( row, modelColumn, root );
+}
+
+QString
+PickerPrivate::rowText( int row ) const
+{
+	if( generated )
+		return ( row >= 0 && row < generatedCount ? generator( row ) :
+			QString() );
+	else
+		return itemText( indexForRow( row ) );
+}
+
+bool
+PickerPrivate::isRowEnabled( int row ) const
+{
+	if( generated )
+		return ( row >= 0 && row < generatedCount );
+	else
+		return indexForRow( row ).flags().testFlag( Qt::ItemIsEnabled );
+}
+
+int
+PickerPrivate::wrapRow( int row ) const
+{
+	const int rowCount = q->count();
+
+	if( rowCount <= 0 )
+		return -1;
+
+	row %= rowCount;
+
+	return ( row < 0 ? row + rowCount : row );
+}
+
+int
+PickerPrivate::visibleRow( int i ) const
+{
+	if( topRow < 0 )
+		return -1;
+	else if( isWrapping() )
+		return wrapRow( topRow + i );
+	else
+		return ( topRow + i < q->count() ? topRow + i : -1 );
+}
+
+bool
+PickerPrivate::isWrapping() const
+{
+	// Until all rows are fetched the last loaded row isn't the last one.
+	return ( wrapping && ( generated || !model->canFetchMore( root ) ) );
+}
+
+int
+PickerPrivate::firstEnabledRow( int start, int end ) const
+{
+	for( int row = start; row <= end; ++row )
+	{
+		if( isRowEnabled( row ) )
+			return row;
+	}
+
+	return -1;
+}
+
+void
+PickerPrivate::fetchMoreIfNeeded()
+{
+	if( generated || fetchPending || !model->canFetchMore( root ) )
+		return;
+
+	// Keep at least one page of loaded rows below the visible ones.
+	if( qMax( topRow, 0 ) + itemsCount * 2 < q->count() )
+		return;
+
+	fetchPending = true;
+
+	// Model inserts fetched rows, it shouldn't happen while painting.
+	QMetaObject::invokeMethod( q, [this] ()
+		{
+			fetchPending = false;
+
+			if( !generated && model->canFetchMore( root ) )
+				model->fetchMore( root );
+		}, Qt::QueuedConnection );
+}
+
+QStringList
+PickerPrivate::rowTexts( int start, int end ) const
+{
+	QStringList result;
+	result.reserve( end - start + 1 );
+
+	for( int row = start; row <= end; ++row )
+		result.append( rowText( row ) );
+
+	return result;
+}
+
+void
+PickerPrivate::rebuildTextIndex()
+{
+	textIndex.clear();
+	textIndexValid = false;
+	textIndexOutdated = false;
+
+	// Result of the previous building is outdated.
+	if( !textIndexWatcher->isFinished() )
+		textIndexWatcher->setFuture( QFuture< TextIndex::Entries > () );
+
+	if( !textIndexEnabled || generated )
+		return;
+
+	// Model can be read only in the GUI thread.
+	const QStringList texts = rowTexts( 0, q->count() - 1 );
+
+	if( texts.size() < minAsyncTextIndexSize )
+	{
+		textIndex.setEntries( TextIndex::build( texts ) );
+		textIndexValid = true;
+
+		return;
+	}
+
+	auto promise = std::make_shared< QPromise< TextIndex::Entries > > ();
+	promise->start();
+
+	textIndexWatcher->setFuture( promise->future() );
+
+	QThreadPool::globalInstance()->start( [promise, texts] ()
+		{
+			promise->addResult( TextIndex::build( texts ) );
+			promise->finish();
+		} );
+}
+
+void
+PickerPrivate::insertTextIndexRows( int start, int end )
+{
+	if( !textIndexEnabled || generated )
+		return;
+
+	if( textIndexValid )
+		textIndex.insertRows( start, rowTexts( start, end ) );
+	else
+		invalidateTextIndex();
+}
+
+void
+PickerPrivate::removeTextIndexRows( int start, int end )
+{
+	if( !textIndexEnabled || generated )
+		return;
+
+	if( textIndexValid )
+		textIndex.removeRows( start, end );
+	else
+		invalidateTextIndex();
+}
+
+void
+PickerPrivate::updateTextIndexRows( int start, int end )
+{
+	if( !textIndexEnabled || generated )
+		return;
+
+	if( textIndexValid )
+		textIndex.updateRows( start, rowTexts( start, end ) );
+	else
+		invalidateTextIndex();
+}
+
+void
+PickerPrivate::invalidateTextIndex()
 {
-	QModelIndex normalized;
+	// Index is rebuilt once when the current building is finished.
+	if( !textIndexWatcher->isFinished() )
+		textIndexOutdated = true;
+	else
+		rebuildTextIndex();
+}
+
+bool
+PickerPrivate::findIndexed( const QVariant & data, int role,
+	Qt::MatchFlags flags, int & row ) const
+{
+	if( !textIndexValid || role != Qt::DisplayRole )
+		return false;
+
+	const Qt::CaseSensitivity cs = ( flags & Qt::MatchCaseSensitive ?
+		Qt::CaseSensitive : Qt::CaseInsensitive );
+	const TextIndex::RowText text = [this] ( int r ) { return rowText( r ); };
+
+	switch( flags & 0x0F )
+	{
+		case Qt::MatchExactly :
+		{
+			// Model compares variants, so only strings can be equal.
+			if( data.userType() != QMetaType::QString )
+				return false;
+
+			row = textIndex.find( data.toString(), false,
+				Qt::CaseSensitive, text );
+		}
+		break;
+
+		case Qt::MatchFixedString :
+			row = textIndex.find( data.toString(), false, cs, text );
+		break;
+
+		case Qt::MatchStartsWith :
+			row = textIndex.find( data.toString(), true, cs, text );
+		break;
+
+		default :
+			return false;
+	}
+
+	return true;
+}
 
-	if( mi.column() != modelColumn )
-		normalized = model->index( mi.row(), modelColumn, mi.parent() );
+int
+PickerPrivate::rowAfterRemoval( int row, int start, int end ) const
+{
+	if( row < start )
+		return row;
+	else if( row <= end )
+		return -1;
+	else
+		return row - ( end - start + 1 );
+}
 
-	if( !normalized.isValid() )
-		normalized = mi;    // Fallback to passed index.
+void
+PickerPrivate::rowsInserted( int start, int end )
+{
+	// set current index if picker was previously empty or
+	// there were no enabled rows before fetching
+	if( currentRow == -1 && ( pendingCurrent ||
+		( start == 0 && ( end - start + 1 ) == q->count() ) ) )
+	{
+		const int row = firstEnabledRow( start, end );
 
-	bool indexChanged = ( normalized != currentIndex );
+		if( row != -1 )
+		{
+			topRow = row;
+			q->setCurrentIndex( row );
+		}
+		else
+		{
+			pendingCurrent = model->canFetchMore( root );
 
-	if( indexChanged )
+			if( isRowsVisible( start, end ) )
+				q->update();
+		}
+	}
+	// need to emit changed if model updated index "silently"
+	else if( currentRow != indexBeforeChange )
 	{
-		currentIndex = QPersistentModelIndex( normalized );
 		q->update();
-		q->_q_emitCurrentIndexChanged( currentIndex );
+		q->_q_emitCurrentIndexChanged();
 	}
+	else if( isRowsVisible( start, end ) )
+		q->update();
 }
 
 QString
@@ -188,37 +564,185 @@ PickerPrivate::sizeHint( const QStyleOption & opt )
 void
 PickerPrivate::computeStringWidth()
 {
-	maxStringWidth = 25;
+	if( widthsValid )
+		return;
+
+	rowWidths.clear();
+	widthsCount.clear();
 
 	const int rowCount = q->count();
 
-	if( rowCount > 0 )
+	if( isWidthsSampled() )
 	{
-		const QFontMetrics & fm = q->fontMetrics();
+		const int sampleSize = widthsSampleSize();
+		const qreal step = (qreal) rowCount / (qreal) sampleSize;
+
+		for( int i = 0; i < sampleSize; ++i )
+			++widthsCount[ rowWidth( qMin( rowCount - 1, (int) ( i * step ) ) ) ];
+
+		// The last item is usually the widest one in numeric ranges.
+		++widthsCount[ rowWidth( rowCount - 1 ) ];
+	}
+	else
+	{
+		rowWidths.reserve( rowCount );
 
 		for( int i = 0; i < rowCount; ++i )
 		{
-			const int width = fm.boundingRect( q->itemText( i ) ).width();
+			const int width = rowWidth( i );
+
+			rowWidths.append( width );
+			++widthsCount[ width ];
+		}
+	}
+
+	widthsValid = true;
+
+	updateMaxStringWidth();
+}
+
+int
+PickerPrivate::rowWidth( int row ) const
+{
+	return q->fontMetrics().boundingRect( q->itemText( row ) ).width();
+}
+
+int
+PickerPrivate::widthsSampleSize() const
+{
+	if( measuredItemsLimit > 0 )
+		return measuredItemsLimit;
+	else if( generated )
+		return maxMeasuredGeneratedItems;
+	else
+		return 0;
+}
+
+bool
+PickerPrivate::isWidthsSampled() const
+{
+	const int sampleSize = widthsSampleSize();
+
+	return ( sampleSize > 0 && q->count() > sampleSize );
+}
+
+void
+PickerPrivate::invalidateWidths()
+{
+	widthsValid = false;
+	rowWidths.clear();
+	widthsCount.clear();
+}
+
+void
+PickerPrivate::insertRowWidths( int start, int end )
+{
+	if( !widthsValid )
+		return;
+
+	if( isWidthsSampled() || start > rowWidths.size() )
+	{
+		invalidateWidths();
+
+		return;
+	}
+
+	rowWidths.insert( start, end - start + 1, 0 );
+
+	for( int i = start; i <= end; ++i )
+	{
+		const int width = rowWidth( i );
+
+		rowWidths[ i ] = width;
+		++widthsCount[ width ];
+	}
+
+	updateMaxStringWidth();
+}
+
+void
+PickerPrivate::removeRowWidths( int start, int end )
+{
+	if( !widthsValid )
+		return;
+
+	if( !rowWidths.size() || end >= rowWidths.size() )
+	{
+		invalidateWidths();
+
+		return;
+	}
+
+	for( int i = start; i <= end; ++i )
+	{
+		auto it = widthsCount.find( rowWidths.at( i ) );
+
+		if( --it.value() == 0 )
+			widthsCount.erase( it );
+	}
+
+	rowWidths.remove( start, end - start + 1 );
+
+	updateMaxStringWidth();
+}
+
+void
+PickerPrivate::updateRowWidths( int start, int end )
+{
+	if( !widthsValid )
+		return;
+
+	if( end >= rowWidths.size() )
+	{
+		invalidateWidths();
+
+		return;
+	}
+
+	for( int i = start; i <= end; ++i )
+	{
+		const int width = rowWidth( i );
+
+		if( width != rowWidths.at( i ) )
+		{
+			auto it = widthsCount.find( rowWidths.at( i ) );
 
-			if( width > maxStringWidth )
-				maxStringWidth = width;
+			if( --it.value() == 0 )
+				widthsCount.erase( it );
+
+			rowWidths[ i ] = width;
+			++widthsCount[ width ];
 		}
 	}
+
+	updateMaxStringWidth();
+}
+
+void
+PickerPrivate::updateMaxStringWidth()
+{
+	maxStringWidth = 25;
+
+	if( !widthsCount.isEmpty() && widthsCount.lastKey() > maxStringWidth )
+		maxStringWidth = widthsCount.lastKey();
 }
 
 void
 PickerPrivate::drawItem( QPainter * p, const QStyleOption & opt, int offset,
-	const QModelIndex & index )
+	int row )
 {
-	if( index.flags() & Qt::ItemIsEnabled )
+	const bool enabled = isRowEnabled( row );
+
+	if( enabled )
 	{
-		if( index != currentIndex )
+		if( row != currentRow )
 			p->setPen( opt.palette.color( QPalette::WindowText ) );
 		else
 			p->setPen( highlightColor );
 	}
 	else
-		p->setPen( lighterColor( opt.palette.color( QPalette::WindowText ), 75 ) );
+		p->setPen( PaletteColors::cached( colors, opt.palette )
+			.shade( QPalette::WindowText, 75 ) );
 
 	const QRect r( opt.rect.x() + itemSideMargin, offset,
 		opt.rect.width() - itemSideMargin * 2, stringHeight );
@@ -226,9 +750,9 @@ PickerPrivate::drawItem( QPainter * p, const QStyleOption & opt, int offset,
 	const int flags = Qt::AlignLeft | Qt::TextSingleLine;
 
 	p->drawText( r, flags,
-		makeString( itemText( index ), r, flags, opt ) );
+		makeString( rowText( row ), r, flags, p->device() ) );
 
-	if( index.flags() & Qt::ItemIsEnabled && index == currentIndex )
+	if( enabled && row == currentRow )
 	{
 		const QRect tickRect( opt.rect.x() + itemSideMargin -
 				opt.fontMetrics.averageCharWidth() -
@@ -243,9 +767,9 @@ PickerPrivate::drawItem( QPainter * p, const QStyleOption & opt, int offset,
 
 QString
 PickerPrivate::makeString( const QString & text, const QRect & r,
-	int flags, const QStyleOption & opt )
+	int flags, const QPaintDevice * device )
 {
-	return accomodateString( text, r, flags, opt );
+	return accomodateString( text, r, flags, q->font(), device );
 }
 
 void
@@ -288,60 +812,52 @@ PickerPrivate::normalizeOffset()
 		int fullItemsCount = drawItemOffset /
 			( itemTopMargin + stringHeight );
 
-		drawItemOffset -= ( itemTopMargin + stringHeight ) * fullItemsCount;
-
-		if( fullItemsCount < 0 )
-		{
-			for( int i = fullItemsCount; i < 0; ++i )
-				makeNextIndex( topItemIndex );
-		}
-		else if( fullItemsCount > 0 )
-		{
-			for( int i = 0; i < fullItemsCount; ++i )
-				makePrevIndex( topItemIndex );
-		}
+		drawItemOffset -= ( itemTopMargin + stringHeight ) * fullItemsCount;
 
 		if( drawItemOffset > 0 )
 		{
 			drawItemOffset -= ( itemTopMargin + stringHeight );
-			makePrevIndex( topItemIndex );
+			++fullItemsCount;
 		}
-	}
-}
 
-void
-PickerPrivate::makePrevIndex( QPersistentModelIndex & index )
-{
-	if( index.row() == 0 )
-		index = model->index( q->count() - 1, modelColumn, root );
-	else
-		index = model->index( index.row() - 1, modelColumn, root );
-}
+		topRow -= fullItemsCount;
 
-void
-PickerPrivate::makeNextIndex( QPersistentModelIndex & index )
-{
-	if( index.row() == q->count() - 1 )
-		index = model->index( 0, modelColumn, root );
-	else
-		index = model->index( index.row() + 1, modelColumn, root );
+		if( isWrapping() )
+			topRow = wrapRow( topRow );
+		else
+		{
+			const int maxTopRow = q->count() - itemsCount;
+
+			if( topRow < 0 )
+			{
+				topRow = 0;
+				drawItemOffset = 0;
+			}
+			else if( topRow > maxTopRow ||
+				( topRow == maxTopRow && drawItemOffset < 0 ) )
+			{
+				topRow = maxTopRow;
+				drawItemOffset = 0;
+			}
+		}
+	}
 }
 
 void
 PickerPrivate::setCurrentIndex( const QPoint & pos )
 {
-	const QModelIndex index = indexForPos( pos );
+	const int row = rowForPos( pos );
 
-	if( index.isValid() && ( index.flags() & Qt::ItemIsEnabled ) )
+	if( isRowEnabled( row ) )
 	{
-		setCurrentIndex( index );
-		emit q->activated( itemText( index ) );
-		emit q->activated( index.row() );
+		setCurrentRow( row );
+		emit q->activated( rowText( row ) );
+		emit q->activated( row );
 	}
 }
 
-QModelIndex
-PickerPrivate::indexForPos( const QPoint & pos )
+int
+PickerPrivate::rowForPos( const QPoint & pos )
 {
 	int offset = drawItemOffset;
 
@@ -351,19 +867,12 @@ PickerPrivate::indexForPos( const QPoint & pos )
 			q->rect().width() - itemSideMargin, stringHeight );
 
 		if( r.contains( pos ) )
-		{
-			QPersistentModelIndex index = topItemIndex;
-
-			for( int j = 0; j < i; ++j )
-				makeNextIndex( index );
-
-			return index;
-		}
+			return visibleRow( i );
 
 		offset += stringHeight + itemTopMargin;
 	}
 
-	return QModelIndex();
+	return -1;
 }
 
 void
@@ -397,19 +906,57 @@ PickerPrivate::isRowsVisible( int start, int end )
 	if( q->count() > itemsCount )
 		++visibleItemsCount;
 
-	QPersistentModelIndex index = topItemIndex;
+	const int top = qMax( topRow, 0 );
 
 	for( int i = 0; i < visibleItemsCount; ++i )
 	{
-		if( index.row() >= start && index.row() <= end )
-			return true;
+		const int row = wrapRow( top + i );
 
-		makeNextIndex( index );
+		if( row >= start && row <= end )
+			return true;
 	}
 
 	return false;
 }
 
+void
+PickerPrivate::drawItems( QPainter * p, const QStyleOption & opt )
+{
+	const int rowCount = q->count();
+
+	int maxCount = itemsCount;
+
+	if( rowCount >= itemsCount )
+		++maxCount;
+
+	const int visibleCount = qMin( maxCount, rowCount );
+
+	strip.setGeometry( opt.rect.width(), itemTopMargin + stringHeight,
+		q->devicePixelRatioF() );
+
+	const bool wrap = isWrapping();
+
+	int pos = strip.rowPosition( topRow, visibleCount, rowCount, wrap );
+
+	if( pos < 0 )
+	{
+		// Render items around visible ones, so scrolling by
+		// a few items doesn't need rendering.
+		const int margin = ( rowCount < itemsCount ? 0 : itemsCount );
+
+		// Without wrapping cells before the first row and after
+		// the last one stay blank.
+		strip.render( wrap ? wrapRow( topRow - margin ) : topRow - margin,
+			visibleCount + margin * 2, rowCount, q->font(),
+			[this, &opt] ( QPainter * sp, int row, int y )
+				{ drawItem( sp, opt, y, row ); }, wrap );
+
+		pos = margin;
+	}
+
+	strip.draw( p, 0, drawItemOffset, pos );
+}
+
 
 //
 // Picker
@@ -440,7 +987,10 @@ Picker::~Picker()
 int
 Picker::count() const
 {
-	return d->model->rowCount( d->root );
+	if( d->generated )
+		return d->generatedCount;
+	else
+		return d->model->rowCount( d->root );
 }
 
 void
@@ -453,10 +1003,15 @@ Picker::setMaxCount( int max )
 		return;
 	}
 
-	if( max < count() )
-		d->model->removeRows( max, count() - max, d->root );
-
 	d->maxCount = max;
+
+	if( max < count() )
+	{
+		if( d->generated )
+			d->setGenerator( max, d->generator );
+		else
+			d->model->removeRows( max, count() - max, d->root );
+	}
 }
 
 int
@@ -468,6 +1023,14 @@ Picker::maxCount() const
 int
 Picker::findData( const QVariant & data, int role, Qt::MatchFlags flags ) const
 {
+	if( d->generated )
+		return d->findGenerated( data, role, flags );
+
+	int row = -1;
+
+	if( d->findIndexed( data, role, flags, row ) )
+		return row;
+
 	QModelIndexList result;
 
 	QModelIndex start = d->model->index( 0, d->modelColumn, d->root );
@@ -497,66 +1060,50 @@ Picker::setModel( QAbstractItemModel * model )
 
 	if( d->model )
 	{
-		disconnect( d->model, &QAbstractItemModel::dataChanged,
-			this, &Picker::_q_dataChanged );
-		disconnect( d->model, &QAbstractItemModel::rowsAboutToBeInserted,
-			this, &Picker::_q_updateIndexBeforeChange );
-		disconnect( d->model, &QAbstractItemModel::rowsInserted,
-			this, &Picker::_q_rowsInserted );
-		disconnect( d->model, &QAbstractItemModel::rowsAboutToBeRemoved,
-			this, &Picker::_q_updateIndexBeforeChange );
-		disconnect( d->model, &QAbstractItemModel::rowsRemoved,
-			this, &Picker::_q_rowsRemoved );
+		d->disconnectModel();
+
 		disconnect( d->model, &QAbstractItemModel::destroyed,
 			this, &Picker::_q_modelDestroyed );
-		disconnect( d->model, &QAbstractItemModel::modelAboutToBeReset,
-			this, &Picker::_q_updateIndexBeforeChange );
-		disconnect( d->model, &QAbstractItemModel::modelReset,
-			this, &Picker::_q_modelReset );
 
 		if( d->model->QObject::parent() == this )
 			delete d->model;
 	}
 
 	d->model = model;
+	d->clearGenerator();
+
+	d->connectModel();
 
-	connect( model, &QAbstractItemModel::dataChanged,
-		this, &Picker::_q_dataChanged );
-	connect( model, &QAbstractItemModel::rowsAboutToBeInserted,
-		this, &Picker::_q_updateIndexBeforeChange );
-	connect( model, &QAbstractItemModel::rowsInserted,
-		this, &Picker::_q_rowsInserted );
-	connect( model, &QAbstractItemModel::rowsAboutToBeRemoved,
-		this, &Picker::_q_updateIndexBeforeChange );
-	connect( model, &QAbstractItemModel::rowsRemoved,
-		this, &Picker::_q_rowsRemoved );
 	connect( model, &QAbstractItemModel::destroyed,
 		this, &Picker::_q_modelDestroyed );
-	connect( model, &QAbstractItemModel::modelAboutToBeReset,
-		this, &Picker::_q_updateIndexBeforeChange );
-	connect( model, &QAbstractItemModel::modelReset,
-		this, &Picker::_q_modelReset );
 
-	bool currentReset = false;
+	d->invalidateWidths();
+	d->rebuildTextIndex();
+	d->strip.invalidate();
+
+	// Rows of the previous model mean nothing for the new one.
+	const bool hadCurrent = ( d->currentRow != -1 );
 
-	if( count() )
+	d->currentRow = -1;
+	d->topRow = -1;
+
+	// Only loaded rows are looked through, the first enabled row
+	// of the lazy model may come with fetched rows.
+	const int row = d->firstEnabledRow( 0, count() - 1 );
+
+	if( row != -1 )
 	{
-		for( int pos = 0; pos < count(); ++pos )
-		{
-			if( d->model->index( pos, d->modelColumn, d->root ).flags() & Qt::ItemIsEnabled )
-			{
-				d->topItemIndex = d->model->index( pos, d->modelColumn, d->root );
-				setCurrentIndex( pos );
-				currentReset = true;
-				break;
-			}
-		}
+		d->topRow = row;
+		setCurrentIndex( row );
 	}
-
-	if( !currentReset )
+	else
 	{
-		setCurrentIndex( -1 );
-		d->topItemIndex = QModelIndex();
+		d->pendingCurrent = model->canFetchMore( d->root );
+
+		update();
+
+		if( hadCurrent )
+			_q_emitCurrentIndexChanged();
 	}
 }
 
@@ -570,6 +1117,9 @@ void
 Picker::setRootModelIndex( const QModelIndex & index )
 {
 	d->root = QPersistentModelIndex( index );
+	d->invalidateWidths();
+	d->rebuildTextIndex();
+	d->strip.invalidate();
 	update();
 }
 
@@ -582,42 +1132,116 @@ Picker::modelColumn() const
 void
 Picker::setModelColumn( int visibleColumn )
 {
-	d->modelColumn = visibleColumn;
+	if( d->modelColumn != visibleColumn )
+	{
+		d->modelColumn = visibleColumn;
+
+		d->invalidateWidths();
+		d->rebuildTextIndex();
+		d->strip.invalidate();
+
+		update();
+
+		//update the text to the text of the new column;
+		if( d->currentRow != -1 )
+			_q_emitCurrentIndexChanged();
+	}
+}
+
+void
+Picker::setGenerator( int count, const TextGenerator & generator )
+{
+	if( count < 0 )
+	{
+		qWarning( "QtMWidgets::Picker::setGenerator: Invalid count (%d) must be >= 0",
+			count );
+		return;
+	}
+
+	if( count > 0 && !generator )
+	{
+		qWarning( "QtMWidgets::Picker::setGenerator: cannot set a 0 generator" );
+		return;
+	}
+
+	d->rangeMinimum = 0;
+	d->rangeStep = 0;
+
+	d->setGenerator( count, generator );
+}
+
+void
+Picker::setRange( int minimum, int maximum, int step, const QString & format )
+{
+	if( step <= 0 || maximum < minimum )
+	{
+		qWarning( "QtMWidgets::Picker::setRange: Invalid range [%d, %d] with step %d",
+			minimum, maximum, step );
+		return;
+	}
+
+	const qint64 count = ( (qint64) maximum - minimum ) / step + 1;
+
+	d->rangeMinimum = minimum;
+	d->rangeStep = step;
+
+	d->setGenerator( (int) qMin( count, (qint64) INT_MAX ),
+		[minimum, step, format] ( int index ) -> QString
+		{
+			const qint64 value = minimum + (qint64) index * step;
+
+			if( format.isEmpty() )
+				return QString::number( value );
+			else
+				return format.arg( value );
+		} );
+}
 
-	setCurrentIndex( currentIndex() ); //update the text to the text of the new column;
+bool
+Picker::hasGenerator() const
+{
+	return d->generated;
 }
 
 int
 Picker::currentIndex() const
 {
-	return d->currentIndex.row();
+	return d->currentRow;
 }
 
 QString
 Picker::currentText() const
 {
-	if( d->currentIndex.isValid() )
-		return d->itemText( d->currentIndex );
-	else
-		return QString();
+	return d->rowText( d->currentRow );
 }
 
 QVariant
 Picker::currentData( int role ) const
 {
-	return d->currentIndex.data( role );
+	return itemData( d->currentRow, role );
 }
 
 QString
 Picker::itemText( int index ) const
 {
-	QModelIndex mi = d->model->index( index, d->modelColumn, d->root );
-	return d->itemText( mi );
+	return d->rowText( index );
 }
 
 QVariant
 Picker::itemData( int index, int role ) const
 {
+	if( d->generated )
+	{
+		if( index < 0 || index >= d->generatedCount )
+			return QVariant();
+		else if( role == Qt::DisplayRole || role == Qt::EditRole )
+			return d->generator( index );
+		else if( role == Qt::UserRole && d->rangeStep > 0 )
+			return (int) ( d->rangeMinimum + (qint64) index * d->rangeStep );
+		else
+			return QVariant();
+	}
+
 	QModelIndex mi = d->model->index( index, d->modelColumn, d->root );
 	return d->model->data( mi, role );
 }
@@ -625,6 +1249,12 @@ Picker::itemData( int index, int role ) const
 void
 Picker::insertItem( int index, const QString & text, const QVariant & userData )
 {
+	if( d->generated )
+	{
+		qWarning( "QtMWidgets::Picker::insertItem: items are generated" );
+		return;
+	}
+
 	int itemCount = count();
 
 	index = qBound( 0, index, itemCount );
@@ -663,7 +1293,9 @@ Picker::insertItem( int index, const QString & text, const QVariant & userData )
 
 			d->inserting = false;
 
-			_q_rowsInserted( d->root, index, index );
+			d->updateRowWidths( index, index );
+			d->updateTextIndexRows( index, index );
+			d->rowsInserted( index, index );
 
 			++itemCount;
 		}
@@ -681,6 +1313,12 @@ Picker::insertItems( int index, const QStringList & texts )
 	if( texts.isEmpty() )
 		return;
 
+	if( d->generated )
+	{
+		qWarning( "QtMWidgets::Picker::insertItems: items are generated" );
+		return;
+	}
+
 	index = qBound( 0, index, count() );
 
 	int insertCount = qMin( d->maxCount - index, texts.count() );
@@ -718,7 +1356,9 @@ Picker::insertItems( int index, const QStringList & texts )
 
 			d->inserting = false;
 
-			_q_rowsInserted( d->root, index, index + insertCount - 1 );
+			d->updateRowWidths( index, index + insertCount - 1 );
+			d->updateTextIndexRows( index, index + insertCount - 1 );
+			d->rowsInserted( index, index + insertCount - 1 );
 
 		}
 		else
@@ -737,12 +1377,24 @@ Picker::removeItem( int index )
 	if( index < 0 || index >= count() )
 		return;
 
+	if( d->generated )
+	{
+		qWarning( "QtMWidgets::Picker::removeItem: items are generated" );
+		return;
+	}
+
 	d->model->removeRows( index, 1, d->root );
 }
 
 void
 Picker::setItemText( int index, const QString & text )
 {
+	if( d->generated )
+	{
+		qWarning( "QtMWidgets::Picker::setItemText: items are generated" );
+		return;
+	}
+
 	QModelIndex item = d->model->index( index, d->modelColumn, d->root );
 
 	if( item.isValid() )
@@ -752,6 +1404,12 @@ Picker::setItemText( int index, const QString & text )
 void
 Picker::setItemData( int index, const QVariant & value, int role )
 {
+	if( d->generated )
+	{
+		qWarning( "QtMWidgets::Picker::setItemData: items are generated" );
+		return;
+	}
+
 	QModelIndex item = d->model->index( index, d->modelColumn, d->root );
 
 	if( item.isValid() )
@@ -770,11 +1428,70 @@ Picker::setHighlightColor( const QColor & c )
 	if( d->highlightColor != c )
 	{
 		d->highlightColor = c;
+		d->strip.invalidate();
 
 		update();
 	}
 }
 
+int
+Picker::measuredItemsLimit() const
+{
+	return d->measuredItemsLimit;
+}
+
+void
+Picker::setMeasuredItemsLimit( int limit )
+{
+	if( limit < 0 )
+	{
+		qWarning( "QtMWidgets::Picker::setMeasuredItemsLimit: Invalid limit (%d) must be >= 0",
+			limit );
+		return;
+	}
+
+	if( d->measuredItemsLimit != limit )
+	{
+		d->measuredItemsLimit = limit;
+		d->invalidateWidths();
+
+		updateGeometry();
+	}
+}
+
+bool
+Picker::wrapping() const
+{
+	return d->wrapping;
+}
+
+void
+Picker::setWrapping( bool on )
+{
+	if( d->wrapping != on )
+	{
+		d->wrapping = on;
+
+		update();
+	}
+}
+
+bool
+Picker::isTextIndexEnabled() const
+{
+	return d->textIndexEnabled;
+}
+
+void
+Picker::setTextIndexEnabled( bool on )
+{
+	if( d->textIndexEnabled != on )
+	{
+		d->textIndexEnabled = on;
+		d->rebuildTextIndex();
+	}
+}
+
 Scroller *
 Picker::scroller() const
 {
@@ -802,6 +1519,15 @@ Picker::minimumSizeHint() const
 void
 Picker::clear()
 {
+	if( d->generated )
+	{
+		d->clearGenerator();
+		d->connectModel();
+
+		d->indexBeforeChange = d->currentRow;
+		_q_modelReset();
+	}
+
 	d->model->removeRows( 0, d->model->rowCount( d->root ), d->root );
 
 #ifndef QT_NO_ACCESSIBILITY
@@ -813,8 +1539,7 @@ Picker::clear()
 void
 Picker::setCurrentIndex( int index )
 {
-	QModelIndex mi = d->model->index( index, d->modelColumn, d->root );
-	d->setCurrentIndex( mi );
+	d->setCurrentRow( index );
 	scrollTo( index );
 }
 
@@ -827,18 +1552,42 @@ Picker::setCurrentText( const QString & text )
 		setCurrentIndex( i );
 }
 
+void
+Picker::keyboardSearch( const QString & search )
+{
+	if( search.isEmpty() )
+		return;
+
+	if( d->keyboardInputTimer.elapsed() > QApplication::keyboardInputInterval() )
+		d->keyboardInput = search;
+	else
+		d->keyboardInput.append( search );
+
+	d->keyboardInputTimer.start();
+
+	const int row = findText( d->keyboardInput, Qt::MatchStartsWith );
+
+	if( d->isRowEnabled( row ) )
+	{
+		setCurrentIndex( row );
+		emit activated( itemText( row ) );
+		emit activated( row );
+	}
+}
+
 void
 Picker::scrollTo( int index )
 {
 	if( count() > d->itemsCount )
 	{
-		QModelIndex mi = d->model->index( index, d->modelColumn, d->root );
-		QPersistentModelIndex top = mi;
-
-		for( int i = 0; i < d->itemsCount / 2; ++i )
-			d->makePrevIndex( top );
+		if( index < 0 || index >= count() )
+			d->topRow = -1;
+		else if( d->isWrapping() )
+			d->topRow = d->wrapRow( index - d->itemsCount / 2 );
+		else
+			d->topRow = qBound( 0, index - d->itemsCount / 2,
+				count() - d->itemsCount );
 
-		d->topItemIndex = top;
 		d->drawItemOffset = 0;
 
 		update();
@@ -846,11 +1595,11 @@ Picker::scrollTo( int index )
 }
 
 void
-Picker::_q_emitCurrentIndexChanged( const QModelIndex & index )
+Picker::_q_emitCurrentIndexChanged()
 {
-	emit currentIndexChanged( index.row() );
+	emit currentIndexChanged( d->currentRow );
 
-	const QString text = d->itemText( index );
+	const QString text = d->rowText( d->currentRow );
 
 	emit currentIndexChanged( text );
 
@@ -869,10 +1618,19 @@ Picker::_q_dataChanged( const QModelIndex & topLeft,
 	if( d->inserting || topLeft.parent() != d->root )
 		return;
 
-	if( d->currentIndex.row() >= topLeft.row() &&
-		d->currentIndex.row() <= bottomRight.row() )
+	if( d->modelColumn >= topLeft.column() &&
+		d->modelColumn <= bottomRight.column() )
 	{
-		const QString text = itemText( d->currentIndex.row() );
+		d->updateRowWidths( topLeft.row(), bottomRight.row() );
+		d->updateTextIndexRows( topLeft.row(), bottomRight.row() );
+	}
+
+	d->strip.invalidate();
+
+	if( d->currentRow >= topLeft.row() &&
+		d->currentRow <= bottomRight.row() )
+	{
+		const QString text = itemText( d->currentRow );
 
 		emit currentTextChanged( text );
 
@@ -890,30 +1648,29 @@ Picker::_q_dataChanged( const QModelIndex & topLeft,
 void
 Picker::_q_updateIndexBeforeChange()
 {
-	d->indexBeforeChange = d->currentIndex.row();
+	d->indexBeforeChange = d->currentRow;
 }
 
 void
 Picker::_q_rowsInserted( const QModelIndex & parent, int start, int end )
 {
-	if( d->inserting || parent != d->root )
+	if( parent != d->root )
 		return;
 
-	// set current index if picker was previously empty
-	if( start == 0 && ( end - start + 1 ) == count() &&
-		!d->currentIndex.isValid() )
-	{
-		d->topItemIndex = d->model->index( 0, d->modelColumn, d->root );
-		setCurrentIndex( 0 );
-	}
-	// need to emit changed if model updated index "silently"
-	else if( d->currentIndex.row() != d->indexBeforeChange )
-	{
-		update();
-		_q_emitCurrentIndexChanged( d->currentIndex );
-	}
-	else if( d->isRowsVisible( start, end ) )
-		update();
+	d->insertRowWidths( start, end );
+	d->insertTextIndexRows( start, end );
+	d->strip.invalidate();
+
+	const int inserted = end - start + 1;
+
+	if( d->currentRow >= start )
+		d->currentRow += inserted;
+
+	if( d->topRow >= start )
+		d->topRow += inserted;
+
+	if( !d->inserting )
+		d->rowsInserted( start, end );
 }
 
 void
@@ -922,19 +1679,26 @@ Picker::_q_rowsRemoved( const QModelIndex & parent, int start, int end )
 	if( parent != d->root )
 		return;
 
+	d->removeRowWidths( start, end );
+	d->removeTextIndexRows( start, end );
+	d->strip.invalidate();
+
+	d->currentRow = d->rowAfterRemoval( d->currentRow, start, end );
+	d->topRow = d->rowAfterRemoval( d->topRow, start, end );
+
 	// model has changed the currentIndex
-	if( d->currentIndex.row() != d->indexBeforeChange )
+	if( d->currentRow != d->indexBeforeChange )
 	{
-		if( !d->currentIndex.isValid() && count() )
+		if( d->currentRow == -1 && count() )
 		{
 			const int index = qMin( count() - 1, qMax( d->indexBeforeChange, 0 ) );
-			d->topItemIndex = d->model->index( index, d->modelColumn, d->root );
+			d->topRow = index;
 			setCurrentIndex( index );
 			return;
 		}
 
 		update();
-		_q_emitCurrentIndexChanged( d->currentIndex );
+		_q_emitCurrentIndexChanged();
 	}
 	else if( d->isRowsVisible( start, end ) )
 		update();
@@ -943,18 +1707,80 @@ Picker::_q_rowsRemoved( const QModelIndex & parent, int start, int end )
 void
 Picker::_q_modelDestroyed()
 {
-	setModel( new QStandardItemModel( 0, 1, this ) );
+	if( d->generated )
+	{
+		// Generated items stay, just replace destroyed model.
+		d->model = new QStandardItemModel( 0, 1, this );
+
+		connect( d->model, &QAbstractItemModel::destroyed,
+			this, &Picker::_q_modelDestroyed );
+	}
+	else
+		setModel( new QStandardItemModel( 0, 1, this ) );
 }
 
 void
 Picker::_q_modelReset()
 {
-	if( d->currentIndex.row() != d->indexBeforeChange )
-		_q_emitCurrentIndexChanged( d->currentIndex );
+	d->currentRow = -1;
+	d->topRow = -1;
+
+	d->invalidateWidths();
+	d->rebuildTextIndex();
+	d->strip.invalidate();
+
+	if( d->currentRow != d->indexBeforeChange )
+		_q_emitCurrentIndexChanged();
+
+	update();
+}
+
+void
+Picker::_q_storePersistentRows()
+{
+	d->indexBeforeChange = d->currentRow;
+	d->persistentCurrent = d->indexForRow( d->currentRow );
+	d->persistentTop = d->indexForRow( d->topRow );
+}
+
+void
+Picker::_q_restorePersistentRows()
+{
+	d->currentRow = ( d->persistentCurrent.isValid() &&
+		d->persistentCurrent.parent() == d->root ?
+			d->persistentCurrent.row() : -1 );
+	d->topRow = ( d->persistentTop.isValid() &&
+		d->persistentTop.parent() == d->root ?
+			d->persistentTop.row() : -1 );
+
+	d->persistentCurrent = QPersistentModelIndex();
+	d->persistentTop = QPersistentModelIndex();
+
+	d->invalidateWidths();
+	d->rebuildTextIndex();
+	d->strip.invalidate();
+
+	if( d->currentRow != d->indexBeforeChange )
+		_q_emitCurrentIndexChanged();
 
 	update();
 }
 
+void
+Picker::_q_textIndexBuilt()
+{
+	const QFuture< TextIndex::Entries > future = d->textIndexWatcher->future();
+
+	// Rows were changed after the snapshot of texts was taken.
+	if( d->textIndexOutdated )
+		d->rebuildTextIndex();
+	else if( future.isFinished() && future.resultCount() > 0 )
+	{
+		d->textIndex.setEntries( future.result() );
+		d->textIndexValid = true;
+	}
+}
+
 void
 Picker::_q_scroll( int dx, int dy )
 {
@@ -964,6 +1790,31 @@ Picker::_q_scroll( int dx, int dy )
 	update();
 }
 
+void
+Picker::changeEvent( QEvent * event )
+{
+	switch( event->type() )
+	{
+		case QEvent::FontChange :
+			d->invalidateWidths();
+			d->strip.invalidate();
+		break;
+
+		case QEvent::PaletteChange :
+		case QEvent::EnabledChange :
+		case QEvent::ActivationChange :
+		case QEvent::StyleChange :
+			d->colors.clear();
+			d->strip.invalidate();
+		break;
+
+		default :
+			break;
+	}
+
+	QWidget::changeEvent( event );
+}
+
 void
 Picker::paintEvent( QPaintEvent * )
 {
@@ -976,35 +1827,18 @@ Picker::paintEvent( QPaintEvent * )
 
 	if( count() > 0 )
 	{
-		if( !d->topItemIndex.isValid() )
+		if( d->topRow < 0 || d->topRow >= count() )
 		{
-			d->topItemIndex = d->model->index( 0, d->modelColumn, d->root );
+			d->topRow = 0;
 			d->drawItemOffset = 0;
 		}
 
 		d->initDrawOffsetForFirstUse();
 		d->normalizeOffset();
-
-		int maxCount = d->itemsCount;
-
-		if( count() >= d->itemsCount )
-			++maxCount;
-
-		int offset = d->drawItemOffset;
-
-		for( int i = d->topItemIndex.row(), itemsCount = 0, scanedItems = 0;
-			( itemsCount < maxCount ) && ( scanedItems < count() ) ;
-			++i, ++scanedItems, ++itemsCount )
-		{
-			if( i == count() )
-				i = 0;
-
-			d->drawItem( &p, opt, offset,
-				d->model->index( i, d->modelColumn, d->root ) );
-
-			offset += d->itemTopMargin + d->stringHeight;
-		}
+		d->drawItems( &p, opt );
 	}
+
+	d->fetchMoreIfNeeded();
 }
 
 void
@@ -1027,6 +1861,23 @@ Picker::wheelEvent( QWheelEvent * event )
 	event->accept();
 }
 
+void
+Picker::keyPressEvent( QKeyEvent * event )
+{
+	const QString text = event->text();
+
+	if( !text.isEmpty() && text.at( 0 ).isPrint() &&
+		!( event->modifiers() & ( Qt::ControlModifier | Qt::AltModifier |
+			Qt::MetaModifier ) ) )
+	{
+		keyboardSearch( text );
+
+		event->accept();
+	}
+	else
+		QWidget::keyPressEvent( event );
+}
+
 void
 Picker::mousePressEvent( QMouseEvent * event )
 {
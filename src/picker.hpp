@@ -13,6 +13,9 @@
 #include <QAbstractItemModel>
 #include <QVariant>
 
+// C++ include.
+#include <functional>
+
 
 namespace QtMWidgets {
 
@@ -33,6 +36,13 @@ class PickerPrivate;
 	The interfase of the Picker is similar to the QComboBox interface.
 	Picker like a QComboBox uses model/view framework too. By default
 	picker uses QStandardItemModel as underlying model.
+
+	For huge numeric or computed ranges picker can work without
+	model, see setGenerator() and setRange(). In this mode texts of
+	items are generated on demand only for visible items.
+
+	Picker accepts keyboard focus, typed text makes current the
+	first item starting with it, see keyboardSearch().
 */
 class Picker
 	:	public QWidget
@@ -111,6 +121,50 @@ class Picker
 		By default this color is QPalette::Highlight.
 	*/
 	Q_PROPERTY( QColor highlightColor READ highlightColor WRITE setHighlightColor )
+	/*!
+		\property measuredItemsLimit
+
+		\brief the maximum number of items measured for the size hint
+
+		Widths of the items are measured once and updated when the
+		model changes. When the picker contains more items than this
+		limit only evenly distributed sample of items with the given
+		size is measured, so the size hint becomes an estimation.
+
+		By default, this property has a value of 0, that means that
+		all items are measured.
+	*/
+	Q_PROPERTY( int measuredItemsLimit READ measuredItemsLimit
+		WRITE setMeasuredItemsLimit )
+	/*!
+		\property wrapping
+
+		\brief whether the picker is circular
+
+		If this property is true, the first item follows the last one
+		when scrolling. If this property is false, scrolling stops at
+		the first and the last items.
+
+		By default, this property has a value of true.
+	*/
+	Q_PROPERTY( bool wrapping READ wrapping WRITE setWrapping )
+	/*!
+		\property textIndexEnabled
+
+		\brief whether the sorted index of items' texts is maintained
+
+		With the index findText() and findData() for Qt::DisplayRole
+		with Qt::MatchExactly, Qt::MatchFixedString or Qt::MatchStartsWith
+		are binary searches instead of the scan of the model. Index of
+		a big model is built on the thread pool, till then the model
+		is scanned. Index is updated when rows are changed.
+
+		Index isn't used in the generator mode.
+
+		By default, this property has a value of false.
+	*/
+	Q_PROPERTY( bool textIndexEnabled READ isTextIndexEnabled
+		WRITE setTextIndexEnabled )
 
 signals:
 	/*!
@@ -147,6 +201,9 @@ signals:
 	void currentTextChanged( const QString & text );
 
 public:
+	//! Generator of the item's text by the item's index.
+	typedef std::function< QString ( int index ) > TextGenerator;
+
 	Picker( QWidget * parent = 0, Qt::WindowFlags f = Qt::WindowFlags() );
 
 	virtual ~Picker();
@@ -227,6 +284,35 @@ public:
 	*/
 	void setModelColumn( int visibleColumn );
 
+	/*!
+		Switch picker to the generator mode. Picker will contain \a count
+		items, text of the item is returned by \a generator for the index
+		of the item when the item is shown. Generator is called from the
+		GUI thread and should be fast.
+
+		In this mode model isn't used, functions that modify items
+		(insertItem(), removeItem(), setItemText(), setItemData())
+		do nothing. To return to the model call setModel() or clear().
+
+		\sa setRange(), hasGenerator()
+	*/
+	void setGenerator( int count, const TextGenerator & generator );
+	/*!
+		Switch picker to the generator mode with numbers from \a minimum
+		to \a maximum with the given \a step. If \a format isn't empty
+		the number is placed in the \a format with QString::arg(),
+		for example "%1 kg".
+
+		Number of the item is available with Qt::UserRole, so
+		currentData() returns the selected number.
+
+		\sa setGenerator()
+	*/
+	void setRange( int minimum, int maximum, int step = 1,
+		const QString & format = QString() );
+	//! \return Are items generated?
+	bool hasGenerator() const;
+
 	/*!
 		\return The index of the current item in the picker.
 
@@ -332,6 +418,33 @@ public:
 	//! Set color used to highlight the current item.
 	void setHighlightColor( const QColor & c );
 
+	/*!
+		\return The maximum number of items measured for the size hint.
+
+		\sa measuredItemsLimit
+	*/
+	int measuredItemsLimit() const;
+	//! Set the maximum number of items measured for the size hint.
+	void setMeasuredItemsLimit( int limit );
+
+	/*!
+		\return Is the picker circular?
+
+		\sa wrapping
+	*/
+	bool wrapping() const;
+	//! Set whether the picker is circular.
+	void setWrapping( bool on );
+
+	/*!
+		\return Is the sorted index of items' texts maintained?
+
+		\sa textIndexEnabled
+	*/
+	bool isTextIndexEnabled() const;
+	//! Set whether the sorted index of items' texts is maintained.
+	void setTextIndexEnabled( bool on );
+
 	//! \return Scroller interface.
 	Scroller * scroller() const;
 
@@ -343,7 +456,8 @@ public slots:
 		Clears the picker, removing all items.
 
 		Note: If you have set an external model on the combobox this model
-		will still be cleared when calling this function.
+		will still be cleared when calling this function. In the generator
+		mode picker returns to the model.
 	*/
 	void clear();
 	/*!
@@ -361,20 +475,31 @@ public slots:
 	void setCurrentText( const QString & text );
 	//! Scroll picker to the \a index.
 	void scrollTo( int index );
+	/*!
+		Make current the first item starting with \a search, case
+		insensitive, if it's enabled. Text typed within
+		QApplication::keyboardInputInterval() is accumulated.
+	*/
+	void keyboardSearch( const QString & search );
 
 private slots:
-	void _q_emitCurrentIndexChanged( const QModelIndex & index );
+	void _q_emitCurrentIndexChanged();
 	void _q_dataChanged( const QModelIndex &, const QModelIndex & );
 	void _q_updateIndexBeforeChange();
 	void _q_rowsInserted( const QModelIndex & parent, int start, int end );
 	void _q_rowsRemoved( const QModelIndex & parent, int start, int end );
 	void _q_modelDestroyed();
 	void _q_modelReset();
+	void _q_storePersistentRows();
+	void _q_restorePersistentRows();
+	void _q_textIndexBuilt();
 	void _q_scroll( int dx, int dy );
 
 protected:
+	void changeEvent( QEvent * event ) override;
 	void paintEvent( QPaintEvent * event ) override;
 	void wheelEvent( QWheelEvent * event ) override;
+	void keyPressEvent( QKeyEvent * event ) override;
 	void mousePressEvent( QMouseEvent * event ) override;
 	void mouseReleaseEvent( QMouseEvent * event ) override;
 	void mouseMoveEvent( QMouseEvent * event ) override;
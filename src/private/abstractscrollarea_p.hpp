@@ -15,7 +15,6 @@
 
 QT_BEGIN_NAMESPACE
 class QStyleOption;
-class QTimer;
 class QVariantAnimation;
 QT_END_NAMESPACE
 
@@ -91,6 +90,8 @@ protected:
 
 
 class Scroller;
+class MoveCoalescer;
+class AnimationTimer;
 
 //
 // AbstractScrollAreaPrivate
@@ -119,6 +120,7 @@ public:
 		,	vertBlur( 0 )
 		,	horBlurAnim( 0 )
 		,	vertBlurAnim( 0 )
+		,	moveCoalescer( 0 )
 	{
 	}
 
@@ -153,8 +155,8 @@ public:
 	QPoint mousePos;
 	ScrollIndicator * horIndicator;
 	ScrollIndicator * vertIndicator;
-	QTimer * animationTimer;
-	QTimer * startBlurAnimTimer;
+	AnimationTimer * animationTimer;
+	AnimationTimer * startBlurAnimTimer;
 	int animationTimeout;
 	int animationAlphaDelta;
 	Scroller * scroller;
@@ -162,6 +164,7 @@ public:
 	BlurEffect * vertBlur;
 	QVariantAnimation * horBlurAnim;
 	QVariantAnimation * vertBlurAnim;
+	MoveCoalescer * moveCoalescer;
 }; // class AbstractScrollAreaPrivate
 
 } /* namespace QtMWidgets */
@@ -0,0 +1,97 @@
+
+/*
+	SPDX-FileCopyrightText: 2014-2024 Igor Mironchik <igor.mironchik@gmail.com>
+	SPDX-License-Identifier: MIT
+*/
+
+// QtMWidgets include.
+#include "animationtimer.hpp"
+
+
+namespace QtMWidgets {
+
+//
+// AnimationTimer
+//
+
+AnimationTimer::AnimationTimer( QObject * parent )
+	:	QAbstractAnimation( parent )
+	,	msecs( 0 )
+	,	singleShot( false )
+	,	loop( 0 )
+{
+	// Repeating animation emits finished() on stop(), so only
+	// single shot timer times out with it.
+	connect( this, &QAbstractAnimation::finished, this,
+		[this] ()
+		{
+			if( singleShot )
+				emit timeout();
+		} );
+
+	// Loop can go back after restart, it's not a timeout.
+	connect( this, &QAbstractAnimation::currentLoopChanged, this,
+		[this] ( int l )
+		{
+			if( l > loop )
+			{
+				loop = l;
+
+				emit timeout();
+			}
+		} );
+}
+
+AnimationTimer::~AnimationTimer()
+{
+}
+
+bool
+AnimationTimer::isActive() const
+{
+	return ( state() == QAbstractAnimation::Running );
+}
+
+bool
+AnimationTimer::isSingleShot() const
+{
+	return singleShot;
+}
+
+void
+AnimationTimer::setSingleShot( bool on )
+{
+	singleShot = on;
+}
+
+int
+AnimationTimer::interval() const
+{
+	return msecs;
+}
+
+void
+AnimationTimer::start( int m )
+{
+	stop();
+
+	msecs = qMax( 1, m );
+	loop = 0;
+
+	setLoopCount( singleShot ? 1 : -1 );
+
+	QAbstractAnimation::start();
+}
+
+int
+AnimationTimer::duration() const
+{
+	return msecs;
+}
+
+void
+AnimationTimer::updateCurrentTime( int )
+{
+}
+
+} /* namespace QtMWidgets */
@@ -0,0 +1,71 @@
+
+/*
+	SPDX-FileCopyrightText: 2014-2024 Igor Mironchik <igor.mironchik@gmail.com>
+	SPDX-License-Identifier: MIT
+*/
+
+#ifndef QTMWIDGETS__PRIVATE__ANIMATIONTIMER_HPP__INCLUDED
+#define QTMWIDGETS__PRIVATE__ANIMATIONTIMER_HPP__INCLUDED
+
+// Qt include.
+#include <QAbstractAnimation>
+
+
+namespace QtMWidgets {
+
+//
+// AnimationTimer
+//
+
+/*!
+	QTimer-like timer driven by the animation driver.
+
+	Timers of QtMWidgets use it instead of QTimer, so they
+	follow VirtualClock when it's active.
+*/
+class AnimationTimer
+	:	public QAbstractAnimation
+{
+	Q_OBJECT
+
+signals:
+	//! Timer timed out.
+	void timeout();
+
+public:
+	explicit AnimationTimer( QObject * parent = 0 );
+	~AnimationTimer() override;
+
+	//! \return Is timer running?
+	bool isActive() const;
+
+	//! \return Is timer single shot?
+	bool isSingleShot() const;
+	//! Set timer to be single shot. By default it's not.
+	void setSingleShot( bool on );
+
+	//! \return Interval in milliseconds.
+	int interval() const;
+
+	//! Start or restart timer with interval \a msecs.
+	void start( int msecs );
+
+	int duration() const override;
+
+protected:
+	void updateCurrentTime( int currentTime ) override;
+
+private:
+	Q_DISABLE_COPY( AnimationTimer )
+
+	//! Interval.
+	int msecs;
+	//! Is single shot?
+	bool singleShot;
+	//! Last loop that timed out.
+	int loop;
+}; // class AnimationTimer
+
+} /* namespace QtMWidgets */
+
+#endif // QTMWIDGETS__PRIVATE__ANIMATIONTIMER_HPP__INCLUDED
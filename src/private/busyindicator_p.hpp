@@ -0,0 +1,106 @@
+
+/*
+	SPDX-FileCopyrightText: 2014-2024 Igor Mironchik <igor.mironchik@gmail.com>
+	SPDX-License-Identifier: MIT
+*/
+
+#ifndef QTMWIDGETS__PRIVATE__BUSYINDICATOR_P_HPP__INCLUDED
+#define QTMWIDGETS__PRIVATE__BUSYINDICATOR_P_HPP__INCLUDED
+
+// QtMWidgets include.
+#include "../busyindicator.hpp"
+
+// Qt include.
+#include <QPixmap>
+#include <QColor>
+#include <QVector>
+#include <QSharedPointer>
+
+QT_BEGIN_NAMESPACE
+class QVariantAnimation;
+QT_END_NAMESPACE
+
+
+namespace QtMWidgets {
+
+//
+// BusyIndicatorFrames
+//
+
+/*!
+	Prerendered frames of the busy indicator. Frames are shared
+	by all indicators with the same radius, color and device
+	pixel ratio, each frame is rendered once on first use.
+*/
+class BusyIndicatorFrames {
+public:
+	BusyIndicatorFrames( int outer, int inner, const QColor & c, qreal r );
+
+	//! \return Is this set for the given parameters?
+	bool isFor( int outer, const QColor & c, qreal r ) const
+	{
+		return ( outerRadius == outer && color == c &&
+			qFuzzyCompare( dpr, r ) );
+	}
+
+	//! \return Frame for the rotation on \a angle degrees.
+	const QPixmap & frame( qreal angle );
+
+	//! \return Shared frames for the given parameters.
+	static QSharedPointer< BusyIndicatorFrames > get( int outerRadius,
+		int innerRadius, const QColor & color, qreal dpr );
+
+	//! Outer radius.
+	int outerRadius;
+	//! Inner radius.
+	int innerRadius;
+	//! Color.
+	QColor color;
+	//! Device pixel ratio.
+	qreal dpr;
+	//! Frames.
+	QVector< QPixmap > frames;
+}; // class BusyIndicatorFrames
+
+
+//
+// BusyIndicatorPrivate
+//
+
+class BusyIndicatorPrivate {
+public:
+	BusyIndicatorPrivate( BusyIndicator * parent )
+		:	q( parent )
+		,	outerRadius( 10 )
+		,	innerRadius( outerRadius * 0.6 )
+		,	size( outerRadius * 2, outerRadius * 2 )
+		,	running( true )
+		,	prerendered( true )
+		,	animation( 0 )
+	{
+	}
+
+	//! \return Private data of the \a indicator.
+	static BusyIndicatorPrivate * get( BusyIndicator * indicator )
+	{
+		return indicator->d.data();
+	}
+
+	void init();
+	//! \return Frames for the current radius, color and pixel ratio.
+	BusyIndicatorFrames * currentFrames();
+
+	BusyIndicator * q;
+	int outerRadius;
+	int innerRadius;
+	QSize size;
+	bool running;
+	bool prerendered;
+	QVariantAnimation * animation;
+	QColor color;
+	QSharedPointer< BusyIndicatorFrames > frames;
+}; // class BusyIndicatorPrivate
+
+} /* namespace QtMWidgets */
+
+#endif // QTMWIDGETS__PRIVATE__BUSYINDICATOR_P_HPP__INCLUDED
@@ -6,9 +6,14 @@
 
 // QtMWidgets include.
 #include "datetimeparser.hpp"
+#include "localetables.hpp"
 
 // Qt include.
 #include <QStyleOption>
+#include <QFontMetrics>
+#include <QFont>
+#include <QHash>
+#include <QPair>
 
 
 namespace QtMWidgets {
@@ -17,10 +22,15 @@ namespace QtMWidgets {
 // Section
 //
 
+//! Maximum count of cached labels of the section.
+static const int maxCachedLabels = 64;
+
 Section::Section()
 	:	type( NoSection )
 	,	zeroesAdded( false )
 	,	sectionWidth( 0 )
+	,	valuesCount( 0 )
+	,	firstValue( 0 )
 	,	currentIndex( -1 )
 	,	offset( 0 )
 {
@@ -30,125 +40,61 @@ Section::Section( Type t )
 	:	type( t )
 	,	zeroesAdded( false )
 	,	sectionWidth( 0 )
+	,	valuesCount( 0 )
+	,	firstValue( 0 )
 	,	currentIndex( -1 )
 	,	offset( 0 )
 {
 }
 
-static inline QString
-maxShortDay( const QStyleOption & opt )
-{
-	int index = 1;
-	int width = 0;
-
-	for( int i = 1; i < 8; ++i )
-	{
-		const int tmpWidth = opt.fontMetrics.boundingRect(
-			QLocale::system().dayName( i, QLocale::ShortFormat ) + QLatin1Char( ' ' ) ).width();
-
-		if( tmpWidth > width  )
-		{
-			index = i;
-			width = tmpWidth;
-		}
-	}
-
-	return QLocale::system().dayName( index, QLocale::ShortFormat );
-}
-
-static inline QString
-maxLongDay( const QStyleOption & opt )
-{
-	int index = 1;
-	int width = 0;
-
-	for( int i = 1; i < 8; ++i )
-	{
-		const int tmpWidth = opt.fontMetrics.boundingRect(
-			QLocale::system().dayName( i ) + QLatin1Char( ' ' ) ).width();
-
-		if( tmpWidth > width  )
-		{
-			index = i;
-			width = tmpWidth;
-		}
-	}
-
-	return QLocale::system().dayName( index );
-}
-
-static inline QString
-maxShortMonth( const QStyleOption & opt )
+int
+Section::maxWidth( const QStyleOption & opt ) const
 {
-	int index = 1;
-	int width = 0;
-
-	for( int i = 1; i < 13; ++i )
-	{
-		const int tmpWidth = opt.fontMetrics.boundingRect(
-			QLocale::system().monthName( i, QLocale::ShortFormat ) + QLatin1Char( ' ' ) ).width();
-
-		if( tmpWidth > width  )
-		{
-			index = i;
-			width = tmpWidth;
-		}
-	}
-
-	return QLocale::system().monthName( index, QLocale::ShortFormat );
+	return maxWidth( opt.fontMetrics );
 }
 
-static inline QString
-maxLongMonth( const QStyleOption & opt )
+int
+Section::maxWidth( const QFont & font ) const
 {
-	int index = 1;
-	int width = 0;
-
-	for( int i = 1; i < 13; ++i )
-	{
-		const int tmpWidth = opt.fontMetrics.boundingRect(
-			QLocale::system().monthName( i ) + QLatin1Char( ' ' ) ).width();
-
-		if( tmpWidth > width  )
-		{
-			index = i;
-			width = tmpWidth;
-		}
-	}
-
-	return QLocale::system().monthName( index );
+	return LocaleTables::system()->width( font,
+		( (int) type << 1 ) | ( zeroesAdded ? 1 : 0 ),
+		[this, &font] () { return maxWidth( QFontMetrics( font ) ); } );
 }
 
 int
-Section::maxWidth( const QStyleOption & opt ) const
+Section::maxWidth( const QFontMetrics & fm ) const
 {
-	int width = opt.fontMetrics.boundingRect( value(
+	const QSharedPointer< const LocaleTables > tables = LocaleTables::system();
+
+	int width = fm.boundingRect( value(
 		DATETIMEPICKER_DATETIME_MAX ) ).width();
 
-	width += opt.fontMetrics.averageCharWidth() / 3;
+	width += fm.averageCharWidth() / 3;
 
 	switch( type )
 	{
 		case DaySectionShort :
 		{
-			width += opt.fontMetrics.boundingRect( maxShortDay( opt ) ).width();
-			width += opt.fontMetrics.averageCharWidth();
+			width += fm.boundingRect(
+				tables->maxDayName( fm, QLocale::ShortFormat ) ).width();
+			width += fm.averageCharWidth();
 		}
 		break;
 
 		case DaySectionLong :
 		{
-			width += opt.fontMetrics.boundingRect( maxLongDay( opt ) ).width();
-			width += opt.fontMetrics.averageCharWidth();
+			width += fm.boundingRect( tables->maxDayName( fm ) ).width();
+			width += fm.averageCharWidth();
 		}
 		break;
 
 		case MonthSectionShort :
-			width += opt.fontMetrics.boundingRect( maxShortMonth( opt ) ).width();
+			width += fm.boundingRect(
+				tables->maxMonthName( fm, QLocale::ShortFormat ) ).width();
 		break;
 
 		case MonthSectionLong :
-			width += opt.fontMetrics.boundingRect( maxLongMonth( opt ) ).width();
+			width += fm.boundingRect( tables->maxMonthName( fm ) ).width();
 		break;
 
 		default:
@@ -161,13 +107,7 @@ Section::maxWidth( const QStyleOption & opt ) const
 static inline void
 makeSectionValue( QString & v, int section, bool zeroesAdded )
 {
-	if( zeroesAdded )
-	{
-		if( section >= 0 && section < 10 )
-			v.append( QLatin1String( "0" ) );
-	}
-
-	v.append( QString::number( section ) );
+	v.append( LocaleTables::system()->number( section, zeroesAdded ) );
 }
 
 QString
@@ -264,12 +204,85 @@ Section::value( const QDateTime & dt ) const
 	return v;
 }
 
-void
+QString
+Section::label( int index ) const
+{
+	if( index < 0 || index >= valuesCount )
+		return QString();
+
+	const auto it = labels.constFind( index );
+
+	if( it != labels.constEnd() )
+		return it.value();
+
+	if( labels.size() >= maxCachedLabels )
+		labels.clear();
+
+	QString v;
+
+	switch( type )
+	{
+		case AmPmSection :
+			v = ( index == 0 ? QLatin1String( "AM" ) : QLatin1String( "PM" ) );
+		break;
+
+		case DaySectionShort :
+		{
+			makeSectionValue( v, firstValue + index, zeroesAdded );
+
+			v.prepend( QLatin1Char( ' ' ) );
+
+			v.prepend( LocaleTables::system()->dayName(
+				month.addDays( index ).dayOfWeek(), QLocale::ShortFormat ) );
+		}
+		break;
+
+		case DaySectionLong :
+		{
+			makeSectionValue( v, firstValue + index, zeroesAdded );
+
+			v.prepend( QLatin1Char( ' ' ) );
+
+			v.prepend( LocaleTables::system()->dayName(
+				month.addDays( index ).dayOfWeek() ) );
+		}
+		break;
+
+		case MonthSectionShort :
+			v = LocaleTables::system()->monthName( firstValue + index,
+				QLocale::ShortFormat );
+		break;
+
+		case MonthSectionLong :
+			v = LocaleTables::system()->monthName( firstValue + index );
+		break;
+
+		case YearSection2Digits :
+		{
+			makeSectionValue( v, firstValue + index, zeroesAdded );
+
+			v = v.right( 2 );
+		}
+		break;
+
+		default :
+			makeSectionValue( v, firstValue + index, zeroesAdded );
+		break;
+	}
+
+	labels.insert( index, v );
+
+	return v;
+}
+
+bool
 Section::fillValues( const QDateTime & current,
 	const QDateTime & min, const QDateTime & max,
 	bool updateIndex )
 {
-	values.clear();
+	const int oldCount = valuesCount;
+	const int oldFirst = firstValue;
+	const QDate oldMonth = month;
 
 	if( updateIndex )
 		currentIndex = -1;
@@ -278,8 +291,8 @@ Section::fillValues( const QDateTime & current,
 	{
 		case AmPmSection :
 		{
-			values.append( QLatin1String( "AM" ) );
-			values.append( QLatin1String( "PM" ) );
+			valuesCount = 2;
+			firstValue = 0;
 
 			if( current.time().hour() >= 12 )
 				currentIndex = 1;
@@ -290,37 +303,17 @@ Section::fillValues( const QDateTime & current,
 
 		case SecondSection :
 		{
-			const int s = current.time().second();
-
-			for( int i = 0; i < 60; ++i )
-			{
-				QString v;
-
-				makeSectionValue( v, i, zeroesAdded );
-
-				if( s == i )
-					currentIndex = values.size();
-
-				values.append( v );
-			}
+			valuesCount = 60;
+			firstValue = 0;
+			currentIndex = current.time().second();
 		}
 		break;
 
 		case MinuteSection :
 		{
-			const int m = current.time().minute();
-
-			for( int i = 0; i < 60; ++i )
-			{
-				QString v;
-
-				makeSectionValue( v, i, zeroesAdded );
-
-				if( m == i )
-					currentIndex = values.size();
-
-				values.append( v );
-			}
+			valuesCount = 60;
+			firstValue = 0;
+			currentIndex = current.time().minute();
 		}
 		break;
 
@@ -336,201 +329,85 @@ Section::fillValues( const QDateTime & current,
 			else
 				h = currentHour;
 
-			for( int i = 1; i < 13; ++i )
-			{
-				QString v;
-
-				makeSectionValue( v, i, zeroesAdded );
-
-				if( h == i )
-					currentIndex = values.size();
-
-				values.append( v );
-			}
+			valuesCount = 12;
+			firstValue = 1;
+			currentIndex = h - firstValue;
 		}
 		break;
 
 		case Hour24Section :
 		{
-			const int h = current.time().hour();
-
-			for( int i = 0; i < 24; ++i )
-			{
-				QString v;
-
-				makeSectionValue( v, i, zeroesAdded );
-
-				if( h == i )
-					currentIndex = values.size();
-
-				values.append( v );
-			}
+			valuesCount = 24;
+			firstValue = 0;
+			currentIndex = current.time().hour();
 		}
 		break;
 
 		case DaySection :
-		{
-			const int d = current.date().day();
-
-			for( int i = 1; i <= current.date().daysInMonth(); ++i )
-			{
-				QString v;
-
-				makeSectionValue( v, i, zeroesAdded );
-
-				if( updateIndex && d == i )
-					currentIndex = values.size();
-
-				values.append( v );
-			}
-		}
-		break;
-
 		case DaySectionShort :
-		{
-			const int d = current.date().day();
-
-			QDate date( current.date().year(), current.date().month(), 1 );
-
-			for( int i = 1; i <= current.date().daysInMonth(); ++i )
-			{
-				QString v;
-
-				makeSectionValue( v, i, zeroesAdded );
-
-				if( updateIndex && d == i )
-					currentIndex = values.size();
-
-				v.prepend( QLatin1Char( ' ' ) );
-
-				v.prepend( QLocale::system().dayName( date.dayOfWeek(), QLocale::ShortFormat ) );
-
-				values.append( v );
-
-				date = date.addDays( 1 );
-			}
-		}
-		break;
-
 		case DaySectionLong :
 		{
-			const int d = current.date().day();
-
-			QDate date( current.date().year(), current.date().month(), 1 );
-
-			for( int i = 1; i <= current.date().daysInMonth(); ++i )
-			{
-				QString v;
-
-				makeSectionValue( v, i, zeroesAdded );
-
-				if( updateIndex && d == i )
-					currentIndex = values.size();
-
-				v.prepend( QLatin1Char( ' ' ) );
+			valuesCount = current.date().daysInMonth();
+			firstValue = 1;
 
-				v.prepend( QLocale::system().dayName( date.dayOfWeek() ) );
+			// Names of the days depend on the month.
+			if( type != DaySection )
+				month = QDate( current.date().year(), current.date().month(), 1 );
 
-				values.append( v );
-
-				date = date.addDays( 1 );
-			}
+			if( updateIndex )
+				currentIndex = current.date().day() - firstValue;
 		}
 		break;
 
 		case MonthSection :
-		{
-			const int m = current.date().month();
-
-			for( int i = 1; i < 13; ++i )
-			{
-				QString v;
-
-				makeSectionValue( v, i, zeroesAdded );
-
-				if( m == i )
-					currentIndex = values.size();
-
-				values.append( v );
-			}
-		}
-		break;
-
 		case MonthSectionShort :
-		{
-			const int m = current.date().month();
-
-			for( int i = 1; i < 13; ++i )
-			{
-				if( m == i )
-					currentIndex = values.size();
-
-				values.append( QLocale::system().monthName( i, QLocale::ShortFormat ) );
-			}
-		}
-		break;
-
 		case MonthSectionLong :
 		{
-			const int m = current.date().month();
-
-			for( int i = 1; i < 13; ++i )
-			{
-				if( m == i )
-					currentIndex = values.size();
-
-				values.append( QLocale::system().monthName( i ) );
-			}
+			valuesCount = 12;
+			firstValue = 1;
+			currentIndex = current.date().month() - firstValue;
 		}
 		break;
 
 		case YearSection :
+		case YearSection2Digits :
 		{
-			int start = min.date().year();
-			const int finish = max.date().year();
 			const int y = current.date().year();
 
-			while( start <= finish )
-			{
-				QString v;
-
-				makeSectionValue( v, start, zeroesAdded );
-
-				if( start == y )
-					currentIndex = values.size();
+			valuesCount = max.date().year() - min.date().year() + 1;
+			firstValue = min.date().year();
 
-				values.append( v );
-
-				++start;
-			}
+			if( y >= firstValue && y < firstValue + valuesCount )
+				currentIndex = y - firstValue;
 		}
 		break;
 
-		case YearSection2Digits :
+		default:
 		{
-			int start = min.date().year();
-			const int finish = max.date().year();
-			const int y = current.date().year();
+			valuesCount = 0;
+			firstValue = 0;
+		}
+		break;
+	}
 
-			while( start <= finish )
-			{
-				QString v;
+	const bool changed = ( valuesCount != oldCount ||
+		firstValue != oldFirst || month != oldMonth );
 
-				makeSectionValue( v, start, zeroesAdded );
+	if( changed )
+		labels.clear();
 
-				if( start == y )
-					currentIndex = values.size();
+	return changed;
+}
 
-				values.append( v.right( 2 ) );
 
-				++start;
-			}
-		}
-		break;
+//
+// SectionFormat
+//
 
-		default:
-			break;
-	}
+SectionFormat::SectionFormat( Section::Type t )
+	:	type( t )
+	,	zeroesAdded( false )
+{
 }
 
 
@@ -562,15 +439,25 @@ countRepeat( const QString &str, int index, int maxCount )
 	return count;
 }
 
-bool
-DateTimeParser::parseFormat( const QString & fmt )
+//! Maximum count of cached compiled formats.
+static const int maxCompiledFormats = 32;
+
+//! Compiled formats.
+typedef QHash< QPair< QString, int >,
+	QSharedPointer< const SectionsFormat > > CompiledFormats;
+
+static CompiledFormats &
+compiledFormats()
 {
-	if( fmt.isEmpty() )
-		return false;
+	static CompiledFormats formats;
 
-	if( fmt == format )
-		return true;
+	return formats;
+}
 
+//! \return Compiled format or null pointer if format is wrong.
+static QSharedPointer< const SectionsFormat >
+compileFormat( const QString & fmt, QMetaType::Type type )
+{
 	const int max = fmt.size();
 
 	int amPmSectIndex = -1;
@@ -581,7 +468,7 @@ DateTimeParser::parseFormat( const QString & fmt )
 	int monthSectIndex = -1;
 	int yearSectIndex = -1;
 
-	QVector< Section > newSections;
+	SectionsFormat newSections;
 
 	for( int i = 0; i < max; ++i )
 	{
@@ -596,7 +483,7 @@ DateTimeParser::parseFormat( const QString & fmt )
 					Section::Type t = ( amPmSectIndex != -1 ) ?
 						Section::Hour12Section : Section::Hour24Section;
 
-					Section s( t );
+					SectionFormat s( t );
 					s.zeroesAdded = ( count == 2 ) ? true : false;
 
 					i += ( count - 1 );
@@ -609,7 +496,7 @@ DateTimeParser::parseFormat( const QString & fmt )
 					else
 					{
 						qWarning( "DateTimeParser: redefinition of the hours section." );
-						return false;
+						return QSharedPointer< const SectionsFormat > ();
 					}
 				}
 			} break;
@@ -620,7 +507,7 @@ DateTimeParser::parseFormat( const QString & fmt )
 				{
 					const int count = countRepeat( fmt, i, 2 );
 
-					Section s( Section::MinuteSection );
+					SectionFormat s( Section::MinuteSection );
 					s.zeroesAdded = ( count == 2 ) ? true : false;
 
 					i += ( count - 1 );
@@ -633,7 +520,7 @@ DateTimeParser::parseFormat( const QString & fmt )
 					else
 					{
 						qWarning( "DateTimeParser: redefinition of the minutes section" );
-						return false;
+						return QSharedPointer< const SectionsFormat > ();
 					}
 				}
 			} break;
@@ -644,7 +531,7 @@ DateTimeParser::parseFormat( const QString & fmt )
 				{
 					const int count = countRepeat( fmt, i, 2 );
 
-					Section s( Section::SecondSection );
+					SectionFormat s( Section::SecondSection );
 					s.zeroesAdded = ( count == 2 ) ? true : false;
 
 					i += ( count - 1 );
@@ -657,7 +544,7 @@ DateTimeParser::parseFormat( const QString & fmt )
 					else
 					{
 						qWarning( "DateTimeParser: redefinition of the seconds section." );
-						return false;
+						return QSharedPointer< const SectionsFormat > ();
 					}
 				}
 			} break;
@@ -666,7 +553,7 @@ DateTimeParser::parseFormat( const QString & fmt )
 			{
 				if( type != QMetaType::QDate )
 				{
-					Section s( Section::AmPmSection );
+					SectionFormat s( Section::AmPmSection );
 
 					if( hourSectIndex != -1 )
 						newSections[ hourSectIndex ].type = Section::Hour12Section;
@@ -679,7 +566,7 @@ DateTimeParser::parseFormat( const QString & fmt )
 					else
 					{
 						qWarning( "DateTimeParser: redefinition of the AM/PM section." );
-						return false;
+						return QSharedPointer< const SectionsFormat > ();
 					}
 				}
 			} break;
@@ -694,7 +581,7 @@ DateTimeParser::parseFormat( const QString & fmt )
 					{
 						Section::Type t = ( count == 2 ?
 							Section::YearSection2Digits : Section::YearSection );
-						Section s( t );
+						SectionFormat s( t );
 
 						i += ( count - 1 );
 
@@ -706,13 +593,13 @@ DateTimeParser::parseFormat( const QString & fmt )
 						else
 						{
 							qWarning( "DateTimeParser: redefinition of the years section." );
-							return false;
+							return QSharedPointer< const SectionsFormat > ();
 						}
 					}
 					else
 					{
 						qWarning( "DateTimeParser: wrong value of the years section." );
-						return false;
+						return QSharedPointer< const SectionsFormat > ();
 					}
 				}
 			} break;
@@ -730,7 +617,7 @@ DateTimeParser::parseFormat( const QString & fmt )
 					else if( count == 4 )
 						t = Section::MonthSectionLong;
 
-					Section s( t );
+					SectionFormat s( t );
 					s.zeroesAdded = ( count == 2 ) ? true : false;
 
 					i += ( count - 1 );
@@ -743,7 +630,7 @@ DateTimeParser::parseFormat( const QString & fmt )
 					else
 					{
 						qWarning( "DateTimeParser: redefinition of the monthes section." );
-						return false;
+						return QSharedPointer< const SectionsFormat > ();
 					}
 				}
 			} break;
@@ -761,7 +648,7 @@ DateTimeParser::parseFormat( const QString & fmt )
 					else if( count == 4 )
 						t = Section::DaySectionLong;
 
-					Section s( t );
+					SectionFormat s( t );
 					s.zeroesAdded = ( count == 2 ) ? true : false;
 
 					i += ( count - 1 );
@@ -774,7 +661,7 @@ DateTimeParser::parseFormat( const QString & fmt )
 					else
 					{
 						qWarning( "DateTimeParser: redefinition of the days section." );
-						return false;
+						return QSharedPointer< const SectionsFormat > ();
 					}
 				}
 			} break;
@@ -785,13 +672,57 @@ DateTimeParser::parseFormat( const QString & fmt )
 			default :
 			{
 				qWarning( "DateTimeParser: prohibited character in the format string." );
-				return false;
+				return QSharedPointer< const SectionsFormat > ();
 			}
 		}
 	}
 
+	return QSharedPointer< const SectionsFormat > (
+		new SectionsFormat( newSections ) );
+}
+
+bool
+DateTimeParser::parseFormat( const QString & fmt )
+{
+	if( fmt.isEmpty() )
+		return false;
+
+	if( fmt == format )
+		return true;
+
+	const QPair< QString, int > key( fmt, type );
+
+	QSharedPointer< const SectionsFormat > compiled =
+		compiledFormats().value( key );
+
+	if( !compiled )
+	{
+		compiled = compileFormat( fmt, type );
+
+		if( !compiled )
+			return false;
+
+		// Parsers keep their sections, compiled formats are only a shortcut.
+		if( compiledFormats().size() >= maxCompiledFormats )
+			compiledFormats().clear();
+
+		compiledFormats().insert( key, compiled );
+	}
+
+	QVector< Section > newSections;
+	newSections.reserve( compiled->size() );
+
+	for( const SectionFormat & f : *compiled )
+	{
+		Section s( f.type );
+		s.zeroesAdded = f.zeroesAdded;
+
+		newSections.append( s );
+	}
+
 	sections.swap( newSections );
 	format = fmt;
+	sectionsFormat = compiled;
 
 	return true;
 }
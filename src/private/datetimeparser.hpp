@@ -12,9 +12,13 @@
 #include <QVariant>
 #include <QDateTime>
 #include <QVector>
+#include <QHash>
+#include <QSharedPointer>
 
 QT_BEGIN_NAMESPACE
 class QStyleOption;
+class QFont;
+class QFontMetrics;
 QT_END_NAMESPACE
 
 
@@ -67,23 +71,49 @@ public:
 
 	//! \return Max width of the section.
 	int maxWidth( const QStyleOption & opt ) const;
+	//! \return Max width of the section measured with \a fm.
+	int maxWidth( const QFontMetrics & fm ) const;
+	/*!
+		\return Max width of the section for the \a font.
+
+		Width is measured once per font and shared by all sections
+		of the same type.
+	*/
+	int maxWidth( const QFont & font ) const;
 
 	//! \return Value of the section for the given \a dt date & time.
 	QString value( const QDateTime & dt ) const;
 
-	//! Fill values.
-	void fillValues( const QDateTime & current,
+	/*!
+		Fill values: compute count of values and the first one for
+		the given range, and index of the \a current value.
+
+		Labels of the values aren't created here, they are generated
+		by label() when needed.
+
+		\return Were values changed?
+	*/
+	bool fillValues( const QDateTime & current,
 		const QDateTime & min, const QDateTime & max,
 		bool updateIndex = true );
 
+	//! \return Label of the value with the given \a index.
+	QString label( int index ) const;
+
 	//! Type of the section.
 	Type type;
 	//! Is value prepended with zeroes?
 	bool zeroesAdded;
 	//! Width of the section.
 	int sectionWidth;
-	//! Values.
-	QVector< QString > values;
+	//! Count of values.
+	int valuesCount;
+	//! Number of the first value, i.e. hour, day, month or year.
+	int firstValue;
+	//! First day of the month for names of the days.
+	QDate month;
+	//! Generated labels.
+	mutable QHash< int, QString > labels;
 	//! Current index.
 	int currentIndex;
 	//! Offset.
@@ -91,6 +121,25 @@ public:
 }; // class Section
 
 
+//
+// SectionFormat
+//
+
+//! Section defined in the format string.
+class SectionFormat {
+public:
+	explicit SectionFormat( Section::Type t = Section::NoSection );
+
+	//! Type of the section.
+	Section::Type type;
+	//! Is value prepended with zeroes?
+	bool zeroesAdded;
+}; // class SectionFormat
+
+//! Parsed format string.
+typedef QVector< SectionFormat > SectionsFormat;
+
+
 //
 // DateTimeParser
 //
@@ -111,6 +160,9 @@ public:
 		If format wasn't parsed correctly then new setting
 		will not apply.
 
+		Parsed formats are cached and shared by all parsers,
+		so each distinct format string is parsed only once.
+
 		\return Is format parsed correctly.
 	*/
 	bool parseFormat( const QString & fmt );
@@ -121,6 +173,8 @@ public:
 	QMetaType::Type type;
 	//! Format string.
 	QString format;
+	//! Parsed format string.
+	QSharedPointer< const SectionsFormat > sectionsFormat;
 }; // class DateTimeParser
 
 } /* namespace QtMWidgets */
@@ -0,0 +1,116 @@
+
+/*
+	SPDX-FileCopyrightText: 2014-2024 Igor Mironchik <igor.mironchik@gmail.com>
+	SPDX-License-Identifier: MIT
+*/
+
+#ifndef QTMWIDGETS__PRIVATE__DATETIMEPICKER_P_HPP__INCLUDED
+#define QTMWIDGETS__PRIVATE__DATETIMEPICKER_P_HPP__INCLUDED
+
+// QtMWidgets include.
+#include "../datetimepicker.hpp"
+#include "../scroller.hpp"
+#include "datetimeparser.hpp"
+#include "itemstrip.hpp"
+#include "palettecolors.hpp"
+
+// Qt include.
+#include <QVector>
+#include <QSharedPointer>
+
+
+namespace QtMWidgets {
+
+//
+// DateTimePickerPrivate
+//
+
+class DateTimePickerPrivate
+	:	public DateTimeParser
+{
+public:
+	DateTimePickerPrivate( DateTimePicker * parent,
+		QMetaType::Type parserType )
+		:	DateTimeParser( parserType )
+		,	q( parent )
+		,	minimum( QDateTime( DATETIMEPICKER_COMPAT_DATE_MIN,
+				DATETIMEPICKER_TIME_MIN ) )
+		,	maximum( DATETIMEPICKER_DATETIME_MAX )
+		,	value( QDateTime( DATETIMEPICKER_DATE_INITIAL,
+				DATETIMEPICKER_TIME_MIN ) )
+		,	spec( Qt::LocalTime )
+		,	itemHeight( 0 )
+		,	itemTopMargin( 0 )
+		,	itemsMaxCount( 5 )
+		,	itemSideMargin( 5 )
+		,	widgetHeight( 0 )
+		,	currentItemY( 0 )
+		,	leftMouseButtonPressed( false )
+		,	movableSection( -1 )
+		,	daysSection( -1 )
+		,	monthSection( -1 )
+		,	yearSection( -1 )
+		,	scroller( new Scroller( q, q ) )
+		,	scrolling( false )
+	{
+		initDaysMonthYearSectionIndex();
+		fillValues();
+	}
+
+	//! \return Private data of the \a picker.
+	static DateTimePickerPrivate * get( DateTimePicker * picker )
+	{
+		return picker->d.data();
+	}
+
+	void updateTimeSpec();
+	void setRange( const QDateTime & min, const QDateTime & max );
+	void setValue( const QDateTime & dt, bool updateIndexes = true );
+	void emitSignals();
+	void normalizeOffset( int section );
+	void normalizeOffsets();
+	void drawSectionItems( int section, QPainter * p,
+		const QStyleOption & opt );
+	void drawSectionItem( int section, QPainter * p,
+		const QStyleOption & opt, int index, const QRect & r );
+	void invalidateStrips();
+	void drawWindow( QPainter * p, const QStyleOption & opt );
+	void findMovableSection( const QPointF & pos );
+	void updateOffset( int delta );
+	void clearOffset();
+	void updateDaysIfNeeded();
+	void updateCurrentDateTime();
+	void initDaysMonthYearSectionIndex();
+	void fillValues( bool updateIndexes = true );
+	bool fillSectionValues( int section, bool updateIndexes );
+	QRect sectionRect( int section ) const;
+	void releaseScrolling();
+
+	DateTimePicker * q;
+	QDateTime minimum;
+	QDateTime maximum;
+	QDateTime value;
+	Qt::TimeSpec spec;
+	int itemHeight;
+	int itemTopMargin;
+	int itemsMaxCount; // Must be odd.
+	int itemSideMargin;
+	int widgetHeight;
+	int currentItemY;
+	QPoint mousePos;
+	bool leftMouseButtonPressed;
+	int movableSection;
+	int daysSection;
+	int monthSection;
+	int yearSection;
+	Scroller * scroller;
+	bool scrolling;
+	//! Rendered items of the sections.
+	QVector< ItemStrip > strips;
+	//! Shades of the palette's colors.
+	QSharedPointer< const PaletteColors > colors;
+}; // class DateTimePickerPrivate
+
+} /* namespace QtMWidgets */
+
+#endif // QTMWIDGETS__PRIVATE__DATETIMEPICKER_P_HPP__INCLUDED
@@ -15,71 +15,209 @@
 #include <QBrush>
 #include <QPen>
 #include <QPainterPath>
+#include <QPixmap>
+#include <QPixmapCache>
+
+// C++ include.
+#include <functional>
+#include <initializer_list>
 
 
 namespace QtMWidgets {
 
+//! Maximum size of the rendered primitive to cache, in kilobytes.
+static const int maxRenderedPrimitiveSize = 1024;
+
+//! Transparent margin around rendered primitive for antialiased edges.
+static const int renderedPrimitiveMargin = 1;
+
+
 //
-// drawCylinder
+// primitiveKey
+//
+
+//! \return Key of the rendered \a primitive with the given \a values.
+static QString
+primitiveKey( const char * primitive, std::initializer_list< qint64 > values )
+{
+	QString key = QLatin1String( primitive );
+
+	for( const qint64 v : values )
+	{
+		key.append( QLatin1Char( '-' ) );
+		key.append( QString::number( v ) );
+	}
+
+	return key;
+}
+
+
+//
+// isPixelAligned
+//
+
+//! \return Does \a t keep pixels as is, i.e. only translates or flips?
+static bool
+isPixelAligned( const QTransform & t )
+{
+	if( t.type() > QTransform::TxScale )
+		return false;
+
+	return ( qFuzzyCompare( qAbs( t.m11() ), 1.0 ) &&
+		qFuzzyCompare( qAbs( t.m22() ), 1.0 ) &&
+		qAbs( t.dx() - qRound( t.dx() ) ) < 0.01 &&
+		qAbs( t.dy() - qRound( t.dy() ) ) < 0.01 );
+}
+
+
+//
+// drawCached
+//
+
+//! Paint primitive in the given rect.
+typedef std::function< void ( QPainter * p, const QRect & r ) > PaintPrimitive;
+
+/*!
+	Draw primitive in \a r from the cache, rendering it with \a paint
+	if it's not cached. Primitive is drawn directly when painter's
+	transformation would resample the pixmap or the primitive is too big.
+*/
+static void
+drawCached( QPainter * p, const QRect & r, const QString & key,
+	const PaintPrimitive & paint )
+{
+	if( r.isEmpty() || !isPixelAligned( p->transform() ) )
+	{
+		paint( p, r );
+
+		return;
+	}
+
+	const qreal dpr = p->device()->devicePixelRatio();
+	const QSize size = r.size() + QSize( renderedPrimitiveMargin * 2,
+		renderedPrimitiveMargin * 2 );
+	const QSize pixelSize = size * dpr;
+	const int cost = qMax( 1, pixelSize.width() * pixelSize.height() * 4 / 1024 );
+
+	if( cost > maxRenderedPrimitiveSize )
+	{
+		paint( p, r );
+
+		return;
+	}
+
+	// Pixmaps are kept in QPixmapCache, it's freed with the application.
+	const QString fullKey = QLatin1String( "QtMWidgets-" ) + key +
+		primitiveKey( "", { qRound( dpr * 100 ),
+			p->testRenderHint( QPainter::Antialiasing ) } );
+
+	QPixmap pixmap;
+
+	if( !QPixmapCache::find( fullKey, &pixmap ) )
+	{
+		pixmap = QPixmap( pixelSize );
+		pixmap.setDevicePixelRatio( dpr );
+		pixmap.fill( Qt::transparent );
+
+		{
+			QPainter pp( &pixmap );
+			pp.setRenderHints( p->renderHints() );
+
+			paint( &pp, QRect( QPoint( renderedPrimitiveMargin,
+				renderedPrimitiveMargin ), r.size() ) );
+		}
+
+		QPixmapCache::insert( fullKey, pixmap );
+	}
+
+	p->drawPixmap( r.topLeft() - QPoint( renderedPrimitiveMargin,
+		renderedPrimitiveMargin ), pixmap );
+}
+
+
+//
+// paintCylinder
 //
 
 void
-drawCylinder( QPainter * p, const QRect & r, const QColor & baseColor,
+paintCylinder( QPainter * p, const QRect & r, const QColor & baseColor,
 	bool roundLeftCorner, bool roundRightCorner )
 {
+	// One HSV conversion for all shades of the cylinder.
+	const QVector< QColor > shades = shadedColors( baseColor,
+		{ -50, 25, -40, 50, 75, 200 } );
+
 	QLinearGradient firstVertLineGradient( QPointF( 0.0, 0.0 ),
 		QPointF( 0.0, 1.0 ) );
 	firstVertLineGradient.setCoordinateMode( QGradient::ObjectBoundingMode );
-	firstVertLineGradient.setColorAt( 0.0, darkerColor( baseColor, 50 ) );
-	firstVertLineGradient.setColorAt( 0.5, lighterColor( baseColor, 25 ) );
-	firstVertLineGradient.setColorAt( 1.0, darkerColor( baseColor, 50 ) );
+	firstVertLineGradient.setColorAt( 0.0, shades.at( 0 ) );
+	firstVertLineGradient.setColorAt( 0.5, shades.at( 1 ) );
+	firstVertLineGradient.setColorAt( 1.0, shades.at( 0 ) );
 
 	QLinearGradient secondVertLineGradient( QPointF( 0.0, 0.0 ),
 		QPointF( 0.0, 1.0 ) );
 	secondVertLineGradient.setCoordinateMode( QGradient::ObjectBoundingMode );
-	secondVertLineGradient.setColorAt( 0.0, darkerColor( baseColor, 40 ) );
-	secondVertLineGradient.setColorAt( 0.5, lighterColor( baseColor, 50 ) );
-	secondVertLineGradient.setColorAt( 1.0, darkerColor( baseColor, 40 ) );
+	secondVertLineGradient.setColorAt( 0.0, shades.at( 2 ) );
+	secondVertLineGradient.setColorAt( 0.5, shades.at( 3 ) );
+	secondVertLineGradient.setColorAt( 1.0, shades.at( 2 ) );
 
 	p->setPen( Qt::NoPen );
 	p->setBrush( firstVertLineGradient );
 
-	p->drawRect( r.x(), roundLeftCorner ? 2 : 0,
+	p->drawRect( r.x(), r.y() + ( roundLeftCorner ? 2 : 0 ),
 		1, roundLeftCorner ? r.height() - 4 : r.height() );
-	p->drawRect( r.x() + r.width() - 1, roundRightCorner ? 2 : 0,
+	p->drawRect( r.x() + r.width() - 1, r.y() + ( roundRightCorner ? 2 : 0 ),
 		1, roundRightCorner ? r.height() - 4 : r.height() );
 
 	p->setBrush( secondVertLineGradient );
 
-	p->drawRect( r.x() + 1, roundLeftCorner ? 1 : 0,
+	p->drawRect( r.x() + 1, r.y() + ( roundLeftCorner ? 1 : 0 ),
 		1, roundLeftCorner ? r.height() - 2 : r.height() );
-	p->drawRect( r.x() + r.width() - 2, roundRightCorner ? 1 : 0,
+	p->drawRect( r.x() + r.width() - 2, r.y() + ( roundRightCorner ? 1 : 0 ),
 		1, roundRightCorner ? r.height() - 2 : r.height() );
 
-	p->drawRect( r.x() + 2, 0, 1, r.height() );
-	p->drawRect( r.x() + r.width() - 3, 0,
+	p->drawRect( r.x() + 2, r.y(), 1, r.height() );
+	p->drawRect( r.x() + r.width() - 3, r.y(),
 		1, r.height() );
 
 	QLinearGradient backgroundGradient( QPointF( 0.0, 0.0 ),
 		QPointF( 0.0, 1.0 ) );
 	backgroundGradient.setCoordinateMode( QGradient::ObjectBoundingMode );
 	backgroundGradient.setColorAt( 0.0, baseColor );
-	backgroundGradient.setColorAt( 0.15, lighterColor( baseColor, 75 ) );
-	backgroundGradient.setColorAt( 0.5, lighterColor( baseColor, 200 ) );
-	backgroundGradient.setColorAt( 0.85, lighterColor( baseColor, 75 ) );
+	backgroundGradient.setColorAt( 0.15, shades.at( 4 ) );
+	backgroundGradient.setColorAt( 0.5, shades.at( 5 ) );
+	backgroundGradient.setColorAt( 0.85, shades.at( 4 ) );
 	backgroundGradient.setColorAt( 1.0, baseColor );
 
 	p->setPen( Qt::NoPen );
 	p->setBrush( backgroundGradient );
-	p->drawRect( r.x() + 3, 0, r.width() - 2 * 3, r.height() );
+	p->drawRect( r.x() + 3, r.y(), r.width() - 2 * 3, r.height() );
 }
 
 
 //
-// drawSliderHandle
+// drawCylinder
 //
 
-void drawSliderHandle( QPainter * p, const QRect & r,
+void
+drawCylinder( QPainter * p, const QRect & r, const QColor & baseColor,
+	bool roundLeftCorner, bool roundRightCorner )
+{
+	// Cylinder always starts at the top.
+	drawCached( p, QRect( r.x(), 0, r.width(), r.height() ),
+		primitiveKey( "cylinder", { r.width(), r.height(), baseColor.rgba(),
+			roundLeftCorner, roundRightCorner } ),
+		[&] ( QPainter * pp, const QRect & pr )
+			{ paintCylinder( pp, pr, baseColor, roundLeftCorner, roundRightCorner ); } );
+}
+
+
+//
+// paintSliderHandle
+//
+
+void
+paintSliderHandle( QPainter * p, const QRect & r,
 	int xRadius, int yRadius, const QColor & borderColor,
 	const QColor & lightColor )
 {
@@ -89,8 +227,10 @@ void drawSliderHandle( QPainter * p, const QRect & r,
 
 	QLinearGradient g( QPointF( 0.0, 0.0 ), QPointF( 0.0, 1.0 ) );
 	g.setCoordinateMode( QGradient::ObjectBoundingMode );
-	g.setColorAt( 0.0, darkerColor( lightColor, 75 ) );
-	g.setColorAt( 1.0, darkerColor( lightColor, 10 ) );
+	const QVector< QColor > shades = shadedColors( lightColor, { -75, -10 } );
+
+	g.setColorAt( 0.0, shades.at( 0 ) );
+	g.setColorAt( 1.0, shades.at( 1 ) );
 
 	p->setPen( Qt::NoPen );
 	p->setBrush( g );
@@ -101,10 +241,27 @@ void drawSliderHandle( QPainter * p, const QRect & r,
 
 
 //
-// drawArrow
+// drawSliderHandle
 //
 
-void drawArrow( QPainter * p, const QRect & r,
+void drawSliderHandle( QPainter * p, const QRect & r,
+	int xRadius, int yRadius, const QColor & borderColor,
+	const QColor & lightColor )
+{
+	drawCached( p, r,
+		primitiveKey( "sliderhandle", { r.width(), r.height(), xRadius, yRadius,
+			borderColor.rgba(), lightColor.rgba() } ),
+		[&] ( QPainter * pp, const QRect & pr )
+			{ paintSliderHandle( pp, pr, xRadius, yRadius, borderColor, lightColor ); } );
+}
+
+
+//
+// paintArrow
+//
+
+void
+paintArrow( QPainter * p, const QRect & r,
 	const QColor & color )
 {
 	const qreal width = r.width() / 3;
@@ -126,10 +283,25 @@ void drawArrow( QPainter * p, const QRect & r,
 
 
 //
-// drawArrow2
+// drawArrow
 //
 
-void drawArrow2( QPainter * p, const QRect & r,
+void drawArrow( QPainter * p, const QRect & r,
+	const QColor & color )
+{
+	drawCached( p, r,
+		primitiveKey( "arrow", { r.width(), r.height(), color.rgba() } ),
+		[&] ( QPainter * pp, const QRect & pr )
+			{ paintArrow( pp, pr, color ); } );
+}
+
+
+//
+// paintArrow2
+//
+
+void
+paintArrow2( QPainter * p, const QRect & r,
 	const QColor & color )
 {
 	const qreal width = r.height() / 3;
@@ -149,4 +321,18 @@ void drawArrow2( QPainter * p, const QRect & r,
 	p->drawPath( path );
 }
 
+
+//
+// drawArrow2
+//
+
+void drawArrow2( QPainter * p, const QRect & r,
+	const QColor & color )
+{
+	drawCached( p, r,
+		primitiveKey( "arrow2", { r.width(), r.height(), color.rgba() } ),
+		[&] ( QPainter * pp, const QRect & pr )
+			{ paintArrow2( pp, pr, color ); } );
+}
+
 } /* namespace QtMWidgets */
@@ -27,6 +27,13 @@ namespace QtMWidgets {
 void drawCylinder( QPainter * p, const QRect & r, const QColor & baseColor,
 	bool roundLeftCorner = true, bool roundRightCorner = true );
 
+/*!
+	Paint cylinder with rect \a r without the cache. Unlike
+	drawCylinder() it starts at r.y().
+*/
+void paintCylinder( QPainter * p, const QRect & r, const QColor & baseColor,
+	bool roundLeftCorner, bool roundRightCorner );
+
 
 //
 // drawSliderHandle
@@ -37,6 +44,11 @@ void drawSliderHandle( QPainter * p, const QRect & r,
 	int xRadius, int yRadius, const QColor & borderColor,
 	const QColor & lightColor );
 
+//! Paint slider's handle without the cache.
+void paintSliderHandle( QPainter * p, const QRect & r,
+	int xRadius, int yRadius, const QColor & borderColor,
+	const QColor & lightColor );
+
 
 //
 // drawArrow
@@ -46,6 +58,10 @@ void drawSliderHandle( QPainter * p, const QRect & r,
 void drawArrow( QPainter * p, const QRect & r,
 	const QColor & color );
 
+//! Paint horizontal arrow looks to the right without the cache.
+void paintArrow( QPainter * p, const QRect & r,
+	const QColor & color );
+
 
 //
 // drawArrow2
@@ -55,6 +71,10 @@ void drawArrow( QPainter * p, const QRect & r,
 void drawArrow2( QPainter * p, const QRect & r,
 	const QColor & color );
 
+//! Paint vertical arrow look to the bottom without the cache.
+void paintArrow2( QPainter * p, const QRect & r,
+	const QColor & color );
+
 } /* namespace QtMWidgets */
 
 #endif // QTMWIDGETS__DRAWING_HPP__INCLUDED
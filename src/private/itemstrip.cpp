@@ -0,0 +1,118 @@
+
+/*
+	SPDX-FileCopyrightText: 2014-2024 Igor Mironchik <igor.mironchik@gmail.com>
+	SPDX-License-Identifier: MIT
+*/
+
+// QtMWidgets include.
+#include "itemstrip.hpp"
+
+// Qt include.
+#include <QPainter>
+
+
+namespace QtMWidgets {
+
+//
+// ItemStrip
+//
+
+ItemStrip::ItemStrip()
+	:	first( 0 )
+	,	count( 0 )
+	,	rowsCount( 0 )
+	,	width( 0 )
+	,	rowHeight( 0 )
+	,	dpr( 1.0 )
+	,	wrap( true )
+	,	valid( false )
+{
+}
+
+void
+ItemStrip::setGeometry( int w, int h, qreal r )
+{
+	if( w != width || h != rowHeight || !qFuzzyCompare( r, dpr ) )
+	{
+		width = w;
+		rowHeight = h;
+		dpr = r;
+
+		invalidate();
+	}
+}
+
+void
+ItemStrip::invalidate()
+{
+	valid = false;
+}
+
+int
+ItemStrip::rowPosition( int row, int visible, int total, bool w ) const
+{
+	if( !valid || total != rowsCount || total <= 0 || w != wrap )
+		return -1;
+
+	int pos = row - first;
+
+	if( wrap )
+	{
+		pos %= total;
+
+		if( pos < 0 )
+			pos += total;
+	}
+	else if( pos < 0 )
+		return -1;
+
+	return ( pos + visible <= count ? pos : -1 );
+}
+
+void
+ItemStrip::render( int f, int c, int total,
+	const QFont & font, const DrawRow & drawRow, bool w )
+{
+	first = f;
+	count = c;
+	rowsCount = total;
+	wrap = w;
+	valid = false;
+
+	if( width <= 0 || rowHeight <= 0 || count <= 0 || rowsCount <= 0 )
+		return;
+
+	const QSize size( width, rowHeight * count );
+
+	if( pixmap.size() != size * dpr ||
+		!qFuzzyCompare( pixmap.devicePixelRatio(), dpr ) )
+	{
+		pixmap = QPixmap( size * dpr );
+		pixmap.setDevicePixelRatio( dpr );
+	}
+
+	pixmap.fill( Qt::transparent );
+
+	QPainter p( &pixmap );
+	p.setFont( font );
+
+	for( int i = 0, row = first; i < count; ++i, ++row )
+	{
+		if( wrap && row == rowsCount )
+			row = 0;
+
+		if( row >= 0 && row < rowsCount )
+			drawRow( &p, row, i * rowHeight );
+	}
+
+	valid = true;
+}
+
+void
+ItemStrip::draw( QPainter * p, int x, int y, int pos ) const
+{
+	if( valid )
+		p->drawPixmap( x, y - pos * rowHeight, pixmap );
+}
+
+} /* namespace QtMWidgets */
@@ -0,0 +1,93 @@
+
+/*
+	SPDX-FileCopyrightText: 2014-2024 Igor Mironchik <igor.mironchik@gmail.com>
+	SPDX-License-Identifier: MIT
+*/
+
+#ifndef QTMWIDGETS__PRIVATE__ITEMSTRIP_HPP__INCLUDED
+#define QTMWIDGETS__PRIVATE__ITEMSTRIP_HPP__INCLUDED
+
+// Qt include.
+#include <QPixmap>
+#include <QFont>
+
+// C++ include.
+#include <functional>
+
+QT_BEGIN_NAMESPACE
+class QPainter;
+QT_END_NAMESPACE
+
+
+namespace QtMWidgets {
+
+//
+// ItemStrip
+//
+
+/*!
+	Cached image of the consecutive rows of the cylinder-like
+	column, i.e. Picker or a section of DateTimePicker.
+
+	Rows are rendered once with some margin around the visible
+	ones, and while scrolling the strip is just blitted at the
+	current offset. Rows wrap around, so the strip can contain
+	the same row more than once. Without wrapping rows out of
+	[0, rowsCount) are left blank.
+*/
+class ItemStrip {
+public:
+	//! Draw \a row at \a y.
+	typedef std::function< void ( QPainter * p, int row, int y ) > DrawRow;
+
+	ItemStrip();
+
+	/*!
+		Set width and height of the row and device pixel ratio.
+		Strip becomes outdated if any of them was changed.
+	*/
+	void setGeometry( int width, int rowHeight, qreal dpr );
+	//! Mark strip as outdated.
+	void invalidate();
+
+	/*!
+		\return Position in the strip of the \a row, when \a visible
+		rows starting from \a row are in the strip, or -1 otherwise.
+	*/
+	int rowPosition( int row, int visible, int rowsCount,
+		bool wrap = true ) const;
+
+	/*!
+		Render \a count rows starting from \a first. If \a wrap is false
+		\a first can be negative and only rows in [0, rowsCount) are drawn.
+	*/
+	void render( int first, int count, int rowsCount,
+		const QFont & font, const DrawRow & drawRow, bool wrap = true );
+
+	//! Draw strip with row at position \a pos placed at ( \a x, \a y ).
+	void draw( QPainter * p, int x, int y, int pos ) const;
+
+private:
+	//! Rendered rows.
+	QPixmap pixmap;
+	//! First row.
+	int first;
+	//! Count of rendered rows.
+	int count;
+	//! Count of rows in the column.
+	int rowsCount;
+	//! Width.
+	int width;
+	//! Height of the row.
+	int rowHeight;
+	//! Device pixel ratio.
+	qreal dpr;
+	//! Do rows wrap around?
+	bool wrap;
+	//! Is strip up to date?
+	bool valid;
+}; // class ItemStrip
+
+} /* namespace QtMWidgets */
+
+#endif // QTMWIDGETS__PRIVATE__ITEMSTRIP_HPP__INCLUDED
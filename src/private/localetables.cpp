@@ -0,0 +1,164 @@
+
+/*
+	SPDX-FileCopyrightText: 2014-2024 Igor Mironchik <igor.mironchik@gmail.com>
+	SPDX-License-Identifier: MIT
+*/
+
+// QtMWidgets include.
+#include "localetables.hpp"
+
+// Qt include.
+#include <QFont>
+#include <QFontMetrics>
+
+
+namespace QtMWidgets {
+
+//
+// LocaleTables
+//
+
+static QSharedPointer< const LocaleTables > & systemTables()
+{
+	static QSharedPointer< const LocaleTables > tables;
+
+	return tables;
+}
+
+static inline int formatIndex( QLocale::FormatType format )
+{
+	return ( format == QLocale::ShortFormat ? 0 : 1 );
+}
+
+LocaleTables::LocaleTables( const QLocale & locale )
+	:	localeName( locale.name() )
+{
+	for( int i = 0; i < 7; ++i )
+	{
+		days[ 0 ][ i ] = locale.dayName( i + 1, QLocale::ShortFormat );
+		days[ 1 ][ i ] = locale.dayName( i + 1 );
+	}
+
+	for( int i = 0; i < 12; ++i )
+	{
+		months[ 0 ][ i ] = locale.monthName( i + 1, QLocale::ShortFormat );
+		months[ 1 ][ i ] = locale.monthName( i + 1 );
+	}
+
+	for( int i = 0; i < 100; ++i )
+	{
+		numbers[ 0 ][ i ] = QString::number( i );
+		numbers[ 1 ][ i ] = numbers[ 0 ][ i ];
+
+		if( i < 10 )
+			numbers[ 1 ][ i ].prepend( QLatin1Char( '0' ) );
+	}
+}
+
+QSharedPointer< const LocaleTables >
+LocaleTables::system()
+{
+	QSharedPointer< const LocaleTables > & tables = systemTables();
+
+	if( !tables )
+		tables.reset( new LocaleTables( QLocale::system() ) );
+
+	return tables;
+}
+
+bool
+LocaleTables::updateSystem()
+{
+	QSharedPointer< const LocaleTables > & tables = systemTables();
+
+	if( tables && tables->name() != QLocale::system().name() )
+	{
+		tables.reset( new LocaleTables( QLocale::system() ) );
+
+		return true;
+	}
+
+	return false;
+}
+
+const QString &
+LocaleTables::name() const
+{
+	return localeName;
+}
+
+const QString &
+LocaleTables::dayName( int day, QLocale::FormatType format ) const
+{
+	return days[ formatIndex( format ) ][ qBound( 1, day, 7 ) - 1 ];
+}
+
+const QString &
+LocaleTables::monthName( int month, QLocale::FormatType format ) const
+{
+	return months[ formatIndex( format ) ][ qBound( 1, month, 12 ) - 1 ];
+}
+
+static inline int
+maxNameIndex( const QFontMetrics & fm, const QString * names, int count )
+{
+	int index = 0;
+	int width = 0;
+
+	for( int i = 0; i < count; ++i )
+	{
+		const int tmpWidth = fm.boundingRect(
+			names[ i ] + QLatin1Char( ' ' ) ).width();
+
+		if( tmpWidth > width  )
+		{
+			index = i;
+			width = tmpWidth;
+		}
+	}
+
+	return index;
+}
+
+const QString &
+LocaleTables::maxDayName( const QFontMetrics & fm,
+	QLocale::FormatType format ) const
+{
+	const QString * names = days[ formatIndex( format ) ];
+
+	return names[ maxNameIndex( fm, names, 7 ) ];
+}
+
+const QString &
+LocaleTables::maxMonthName( const QFontMetrics & fm,
+	QLocale::FormatType format ) const
+{
+	const QString * names = months[ formatIndex( format ) ];
+
+	return names[ maxNameIndex( fm, names, 12 ) ];
+}
+
+QString
+LocaleTables::number( int n, bool zeroAdded ) const
+{
+	if( n >= 0 && n < 100 )
+		return numbers[ zeroAdded ? 1 : 0 ][ n ];
+	else
+		return QString::number( n );
+}
+
+int
+LocaleTables::width( const QFont & font, int key,
+	const std::function< int () > & measure ) const
+{
+	const QPair< QString, int > k( font.key(), key );
+
+	auto it = widths.constFind( k );
+
+	if( it == widths.constEnd() )
+		it = widths.insert( k, measure() );
+
+	return it.value();
+}
+
+} /* namespace QtMWidgets */
@@ -0,0 +1,106 @@
+
+/*
+	SPDX-FileCopyrightText: 2014-2024 Igor Mironchik <igor.mironchik@gmail.com>
+	SPDX-License-Identifier: MIT
+*/
+
+#ifndef QTMWIDGETS__PRIVATE__LOCALETABLES_HPP__INCLUDED
+#define QTMWIDGETS__PRIVATE__LOCALETABLES_HPP__INCLUDED
+
+// Qt include.
+#include <QString>
+#include <QLocale>
+#include <QHash>
+#include <QPair>
+#include <QSharedPointer>
+
+// C++ include.
+#include <functional>
+
+QT_BEGIN_NAMESPACE
+class QFont;
+class QFontMetrics;
+QT_END_NAMESPACE
+
+
+namespace QtMWidgets {
+
+//
+// LocaleTables
+//
+
+/*!
+	Names of the days and months of the system locale, numbers
+	used by date & time sections and measured widths of the
+	sections.
+
+	Tables are shared by all date & time pickers, so names are
+	queried and widths are measured once per process instead
+	of once per widget. Tables are used from the GUI thread only.
+*/
+class LocaleTables {
+public:
+	//! \return Tables of the system locale.
+	static QSharedPointer< const LocaleTables > system();
+
+	/*!
+		Rebuild tables if the name of the system locale was changed.
+		Should be called on QEvent::LocaleChange.
+
+		\return Were tables rebuilt?
+	*/
+	static bool updateSystem();
+
+	//! \return Name of the locale.
+	const QString & name() const;
+
+	//! \return Name of the \a day, 1 is Monday.
+	const QString & dayName( int day,
+		QLocale::FormatType format = QLocale::LongFormat ) const;
+	//! \return Name of the \a month, 1 is January.
+	const QString & monthName( int month,
+		QLocale::FormatType format = QLocale::LongFormat ) const;
+
+	/*!
+		\return Name of the day with the biggest width,
+		measured with the trailing space.
+	*/
+	const QString & maxDayName( const QFontMetrics & fm,
+		QLocale::FormatType format = QLocale::LongFormat ) const;
+	//! \return Name of the month with the biggest width.
+	const QString & maxMonthName( const QFontMetrics & fm,
+		QLocale::FormatType format = QLocale::LongFormat ) const;
+
+	/*!
+		\return String of the number \a n, prepended with zero
+		for numbers less than 10 if \a zeroAdded is true.
+	*/
+	QString number( int n, bool zeroAdded ) const;
+
+	/*!
+		\return Width with the given \a key for the \a font. Width is
+		computed with \a measure at the first request and cached.
+	*/
+	int width( const QFont & font, int key,
+		const std::function< int () > & measure ) const;
+
+private:
+	explicit LocaleTables( const QLocale & locale );
+
+	Q_DISABLE_COPY( LocaleTables )
+
+	//! Name of the locale.
+	QString localeName;
+	//! Short and long names of the days.
+	QString days[ 2 ][ 7 ];
+	//! Short and long names of the months.
+	QString months[ 2 ][ 12 ];
+	//! Numbers from 0 to 99 without and with leading zero.
+	QString numbers[ 2 ][ 100 ];
+	//! Measured widths.
+	mutable QHash< QPair< QString, int >, int > widths;
+}; // class LocaleTables
+
+} /* namespace QtMWidgets */
+
+#endif // QTMWIDGETS__PRIVATE__LOCALETABLES_HPP__INCLUDED
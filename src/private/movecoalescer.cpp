@@ -0,0 +1,80 @@
+
+/*
+	SPDX-FileCopyrightText: 2014-2024 Igor Mironchik <igor.mironchik@gmail.com>
+	SPDX-License-Identifier: MIT
+*/
+
+// QtMWidgets include.
+#include "movecoalescer.hpp"
+
+
+namespace QtMWidgets {
+
+//
+// MoveCoalescer
+//
+
+MoveCoalescer::MoveCoalescer( QObject * parent )
+	:	QAbstractAnimation( parent )
+	,	hasPending( false )
+{
+}
+
+MoveCoalescer::~MoveCoalescer()
+{
+}
+
+void
+MoveCoalescer::addMove( const QPoint & delta )
+{
+	if( delta.isNull() )
+		return;
+
+	pending += delta;
+	hasPending = true;
+
+	// Starting animation updates current time, so the first
+	// movement is delivered without waiting for the frame.
+	if( state() != QAbstractAnimation::Running )
+		start();
+}
+
+void
+MoveCoalescer::flush()
+{
+	if( hasPending )
+	{
+		const QPoint delta = pending;
+
+		pending = QPoint();
+		hasPending = false;
+
+		emit moved( delta );
+	}
+}
+
+void
+MoveCoalescer::reset()
+{
+	pending = QPoint();
+	hasPending = false;
+
+	stop();
+}
+
+int
+MoveCoalescer::duration() const
+{
+	return -1;
+}
+
+void
+MoveCoalescer::updateCurrentTime( int )
+{
+	if( hasPending )
+		flush();
+	else
+		stop();
+}
+
+} /* namespace QtMWidgets */
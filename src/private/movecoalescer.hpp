@@ -0,0 +1,66 @@
+
+/*
+	SPDX-FileCopyrightText: 2014-2024 Igor Mironchik <igor.mironchik@gmail.com>
+	SPDX-License-Identifier: MIT
+*/
+
+#ifndef QTMWIDGETS__PRIVATE__MOVECOALESCER_HPP__INCLUDED
+#define QTMWIDGETS__PRIVATE__MOVECOALESCER_HPP__INCLUDED
+
+// Qt include.
+#include <QAbstractAnimation>
+#include <QPoint>
+
+
+namespace QtMWidgets {
+
+//
+// MoveCoalescer
+//
+
+/*!
+	Accumulates drag movement between animation frames and
+	delivers it as one delta per frame.
+
+	The first movement after idle is delivered immediately,
+	all following movements are summed up and delivered on the
+	next tick of the animation driver. Coalescer stops itself
+	on the first frame without movement.
+*/
+class MoveCoalescer
+	:	public QAbstractAnimation
+{
+	Q_OBJECT
+
+signals:
+	//! Accumulated movement \a delta should be applied.
+	void moved( const QPoint & delta );
+
+public:
+	explicit MoveCoalescer( QObject * parent = 0 );
+	~MoveCoalescer() override;
+
+	//! Add movement \a delta.
+	void addMove( const QPoint & delta );
+	//! Deliver pending movement right now.
+	void flush();
+	//! Drop pending movement.
+	void reset();
+
+	int duration() const override;
+
+protected:
+	void updateCurrentTime( int currentTime ) override;
+
+private:
+	Q_DISABLE_COPY( MoveCoalescer )
+
+	//! Pending movement.
+	QPoint pending;
+	//! Is there pending movement?
+	bool hasPending;
+}; // class MoveCoalescer
+
+} /* namespace QtMWidgets */
+
+#endif // QTMWIDGETS__PRIVATE__MOVECOALESCER_HPP__INCLUDED
@@ -0,0 +1,102 @@
+
+/*
+	SPDX-FileCopyrightText: 2014-2024 Igor Mironchik <igor.mironchik@gmail.com>
+	SPDX-License-Identifier: MIT
+*/
+
+// QtMWidgets include.
+#include "palettecolors.hpp"
+#include "../color.hpp"
+
+// Qt include.
+#include <QHash>
+#include <QPair>
+
+
+namespace QtMWidgets {
+
+//! Maximum number of cached palettes.
+static const int maxCachedPalettes = 32;
+
+
+//
+// PaletteColors
+//
+
+PaletteColors::PaletteColors( const QPalette & p )
+	:	palette( p )
+{
+	// Disabled and secondary texts.
+	addShades( QPalette::WindowText, { 75 } );
+	// Cylinders and the window of the current item.
+	addShades( QPalette::Dark, { -50, -40, 25, 35, 50, 75, 95, 110, 200 } );
+	// Unchecked switch.
+	addShades( QPalette::Base, { -75, -25, -10 } );
+}
+
+QColor
+PaletteColors::shade( QPalette::ColorRole role, int bias ) const
+{
+	for( int i = 0; i < colors.size(); ++i )
+	{
+		if( roles.at( i ) == role && biases.at( i ) == bias )
+			return colors.at( i );
+	}
+
+	if( bias > 0 )
+		return lighterColor( palette.color( role ), bias );
+	else
+		return darkerColor( palette.color( role ), -bias );
+}
+
+QSharedPointer< const PaletteColors >
+PaletteColors::forPalette( const QPalette & palette )
+{
+	typedef QPair< qint64, int > Key;
+
+	static QHash< Key, QSharedPointer< const PaletteColors > > cache;
+
+	const Key key( palette.cacheKey(), palette.currentColorGroup() );
+
+	auto it = cache.constFind( key );
+
+	if( it != cache.cend() )
+		return it.value();
+
+	// Widgets hold shared pointers to their tables, dropping the cache
+	// frees only tables of palettes no widget paints with.
+	if( cache.size() >= maxCachedPalettes )
+		cache.clear();
+
+	QSharedPointer< const PaletteColors > colors(
+		new PaletteColors( palette ) );
+
+	cache.insert( key, colors );
+
+	return colors;
+}
+
+const PaletteColors &
+PaletteColors::cached( QSharedPointer< const PaletteColors > & colors,
+	const QPalette & palette )
+{
+	if( !colors )
+		colors = PaletteColors::forPalette( palette );
+
+	return *colors;
+}
+
+void
+PaletteColors::addShades( QPalette::ColorRole role, const QVector< int > & b )
+{
+	const QVector< QColor > shades = shadedColors( palette.color( role ), b );
+
+	for( int i = 0; i < b.size(); ++i )
+	{
+		roles.append( role );
+		biases.append( b.at( i ) );
+		colors.append( shades.at( i ) );
+	}
+}
+
+} /* namespace QtMWidgets */
@@ -0,0 +1,70 @@
+
+/*
+	SPDX-FileCopyrightText: 2014-2024 Igor Mironchik <igor.mironchik@gmail.com>
+	SPDX-License-Identifier: MIT
+*/
+
+#ifndef QTMWIDGETS__PRIVATE__PALETTECOLORS_HPP__INCLUDED
+#define QTMWIDGETS__PRIVATE__PALETTECOLORS_HPP__INCLUDED
+
+// Qt include.
+#include <QPalette>
+#include <QColor>
+#include <QVector>
+#include <QSharedPointer>
+
+
+namespace QtMWidgets {
+
+//
+// PaletteColors
+//
+
+/*!
+	Lighter and darker shades of the palette's colors used by
+	the widgets while painting.
+
+	Shades are computed once per palette and color group, and
+	shared by all widgets with the same palette. Widgets should
+	drop their tables on QEvent::PaletteChange, QEvent::StyleChange,
+	QEvent::EnabledChange and QEvent::ActivationChange. Tables are
+	used from the GUI thread only.
+*/
+class PaletteColors {
+public:
+	explicit PaletteColors( const QPalette & palette );
+
+	/*!
+		\return Color of the \a role shaded with HSV value \a bias,
+		positive bias is lighter and negative is darker.
+	*/
+	QColor shade( QPalette::ColorRole role, int bias ) const;
+
+	//! \return Shades of the \a palette in its current color group.
+	static QSharedPointer< const PaletteColors > forPalette(
+		const QPalette & palette );
+	/*!
+		\return Shades kept by the widget in \a colors, they are
+		taken for the \a palette if the widget dropped them.
+	*/
+	static const PaletteColors & cached(
+		QSharedPointer< const PaletteColors > & colors,
+		const QPalette & palette );
+
+private:
+	//! Add shades of the \a role with the given \a biases.
+	void addShades( QPalette::ColorRole role, const QVector< int > & biases );
+
+	//! Palette.
+	QPalette palette;
+	//! Roles of the shades.
+	QVector< QPalette::ColorRole > roles;
+	//! Biases of the shades.
+	QVector< int > biases;
+	//! Shades.
+	QVector< QColor > colors;
+}; // class PaletteColors
+
+} /* namespace QtMWidgets */
+
+#endif // QTMWIDGETS__PRIVATE__PALETTECOLORS_HPP__INCLUDED
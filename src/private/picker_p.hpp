@@ -0,0 +1,206 @@
+
+/*
+	SPDX-FileCopyrightText: 2014-2024 Igor Mironchik <igor.mironchik@gmail.com>
+	SPDX-License-Identifier: MIT
+*/
+
+#ifndef QTMWIDGETS__PRIVATE__PICKER_P_HPP__INCLUDED
+#define QTMWIDGETS__PRIVATE__PICKER_P_HPP__INCLUDED
+
+// QtMWidgets include.
+#include "../picker.hpp"
+#include "../virtualclock.hpp"
+#include "itemstrip.hpp"
+#include "textindex.hpp"
+#include "palettecolors.hpp"
+
+// Qt include.
+#include <QPersistentModelIndex>
+#include <QVector>
+#include <QMap>
+#include <QFutureWatcher>
+#include <QSharedPointer>
+
+
+namespace QtMWidgets {
+
+class Scroller;
+
+
+//
+// PickerPrivate
+//
+
+class PickerPrivate {
+public:
+	PickerPrivate( Picker * parent )
+		:	q( parent )
+		,	model( 0 )
+		,	modelColumn( 0 )
+		,	currentRow( -1 )
+		,	topRow( -1 )
+		,	drawItemOffset( 0 )
+		,	indexBeforeChange( -1 )
+		,	inserting( false )
+		,	maxCount( INT_MAX )
+		,	minStringLength( 6 )
+		,	maxStringWidth( 25 )
+		,	widthsValid( false )
+		,	measuredItemsLimit( 0 )
+		,	stringLength( minStringLength )
+		,	itemsCount( 5 )
+		,	itemTopMargin( 7 )
+		,	itemSideMargin( 0 )
+		,	stringHeight( 0 )
+		,	leftMouseButtonPressed( false )
+		,	mouseWasMoved( false )
+		,	wasPainted( false )
+		,	mouseMoveDelta( 0 )
+		,	scroller( 0 )
+		,	wrapping( true )
+		,	generated( false )
+		,	generatedCount( 0 )
+		,	rangeMinimum( 0 )
+		,	rangeStep( 0 )
+		,	pendingCurrent( false )
+		,	fetchPending( false )
+		,	textIndexEnabled( false )
+		,	textIndexValid( false )
+		,	textIndexOutdated( false )
+		,	textIndexWatcher( 0 )
+	{}
+
+	//! \return Private data of the \a picker.
+	static PickerPrivate * get( Picker * picker )
+	{
+		return picker->d.data();
+	}
+
+	void init();
+	void connectModel();
+	void disconnectModel();
+	void setGenerator( int count, const Picker::TextGenerator & gen );
+	void clearGenerator();
+	int findGenerated( const QVariant & data, int role,
+		Qt::MatchFlags flags ) const;
+	void setCurrentRow( int row );
+	QModelIndex indexForRow( int row ) const;
+	QString rowText( int row ) const;
+	bool isRowEnabled( int row ) const;
+	int wrapRow( int row ) const;
+	int visibleRow( int i ) const;
+	bool isWrapping() const;
+	int firstEnabledRow( int start, int end ) const;
+	void fetchMoreIfNeeded();
+	QStringList rowTexts( int start, int end ) const;
+	void rebuildTextIndex();
+	void insertTextIndexRows( int start, int end );
+	void removeTextIndexRows( int start, int end );
+	void updateTextIndexRows( int start, int end );
+	//! Rebuild text index or schedule rebuilding if it's being built.
+	void invalidateTextIndex();
+	bool findIndexed( const QVariant & data, int role,
+		Qt::MatchFlags flags, int & row ) const;
+	int rowAfterRemoval( int row, int start, int end ) const;
+	void rowsInserted( int start, int end );
+	QString itemText( const QModelIndex & index ) const;
+	QSize minimumSizeHint( const QStyleOption & opt );
+	QSize sizeHint( const QStyleOption & opt );
+	void computeStringWidth();
+	int rowWidth( int row ) const;
+	int widthsSampleSize() const;
+	bool isWidthsSampled() const;
+	void invalidateWidths();
+	void insertRowWidths( int start, int end );
+	void removeRowWidths( int start, int end );
+	void updateRowWidths( int start, int end );
+	void updateMaxStringWidth();
+	void drawItem( QPainter * p, const QStyleOption & opt, int offset,
+		int row );
+	void normalizeOffset();
+	QString makeString( const QString & text, const QRect & r, int flags,
+		const QPaintDevice * device );
+	void drawTick( const QRect & r, QPainter * p );
+	void setCurrentIndex( const QPoint & pos );
+	int rowForPos( const QPoint & pos );
+	void initDrawOffsetForFirstUse();
+	bool isIndexesVisible( const QModelIndex & topLeft,
+		const QModelIndex & bottomRight );
+	bool isRowsVisible( int start, int end );
+	void drawItems( QPainter * p, const QStyleOption & opt );
+
+	Picker * q;
+	QAbstractItemModel * model;
+	int modelColumn;
+	//! Row of the current item, -1 if there is no current item.
+	int currentRow;
+	QPersistentModelIndex root;
+	//! Row of the top visible item, -1 if not initialized yet.
+	int topRow;
+	//! Current and top items while model changes layout or moves rows.
+	QPersistentModelIndex persistentCurrent;
+	QPersistentModelIndex persistentTop;
+	int drawItemOffset;
+	int indexBeforeChange;
+	bool inserting;
+	int maxCount;
+	int minStringLength;
+	int maxStringWidth;
+	//! Widths of the items' texts.
+	QVector< int > rowWidths;
+	//! Count of items with the given width.
+	QMap< int, int > widthsCount;
+	//! Are widths measured?
+	bool widthsValid;
+	int measuredItemsLimit;
+	int stringLength;
+	int itemsCount;
+	int itemTopMargin;
+	int itemSideMargin;
+	int stringHeight;
+	QPoint mousePos;
+	bool leftMouseButtonPressed;
+	bool mouseWasMoved;
+	bool wasPainted;
+	int mouseMoveDelta;
+	QColor highlightColor;
+	Scroller * scroller;
+	//! Rendered items.
+	ItemStrip strip;
+	//! Is the picker circular?
+	bool wrapping;
+	//! Are items generated?
+	bool generated;
+	//! Count of generated items.
+	int generatedCount;
+	//! Generator of items' texts.
+	Picker::TextGenerator generator;
+	//! Minimum of the range.
+	int rangeMinimum;
+	//! Step of the range, 0 if items aren't a range.
+	int rangeStep;
+	//! Should the first enabled fetched item become current?
+	bool pendingCurrent;
+	//! Is fetching of more rows scheduled?
+	bool fetchPending;
+	//! Is text index enabled?
+	bool textIndexEnabled;
+	//! Is text index up to date?
+	bool textIndexValid;
+	//! Were rows changed while text index was being built?
+	bool textIndexOutdated;
+	//! Sorted texts of the items.
+	TextIndex textIndex;
+	//! Watcher of the text index building on the thread pool.
+	QFutureWatcher< TextIndex::Entries > * textIndexWatcher;
+	//! Text typed for keyboard search.
+	QString keyboardInput;
+	//! Time since the last typed text.
+	ElapsedTimer keyboardInputTimer;
+	//! Shades of the palette's colors.
+	QSharedPointer< const PaletteColors > colors;
+}; // class PickerPrivate
+
+} /* namespace QtMWidgets */
+
+#endif // QTMWIDGETS__PRIVATE__PICKER_P_HPP__INCLUDED
@@ -29,6 +29,11 @@ public:
 	explicit ScrollAreaPrivate( ScrollArea * parent )
 		:	AbstractScrollAreaPrivate( parent )
 		,	resizable( false )
+		,	sizesValid( false )
+		,	hfwWidth( -1 )
+		,	hfwHeight( 0 )
+		,	updatingScrolledSize( false )
+		,	scrolledSizeUpdatePending( false )
 	{
 	}
 
@@ -37,6 +42,10 @@ public:
 	}
 
 	void updateScrolledSize();
+	//! Forget cached sizes of the widget.
+	void invalidateSizes();
+	//! Update scrolled size once in the next event loop iteration.
+	void scheduleScrolledSizeUpdate();
 	void updateWidgetPosition();
 	void paintEvent( QPaintEvent * e );
 
@@ -46,6 +55,18 @@ public:
 	QPointer< QWidget > widget;
 	bool resizable;
 	Qt::Alignment alignment;
+	//! Are cached sizes of the widget valid?
+	bool sizesValid;
+	//! Cached minimum and maximum sizes of the widget.
+	QSize minSize;
+	QSize maxSize;
+	//! Cached height for width of the widget.
+	int hfwWidth;
+	int hfwHeight;
+	//! Is scrolled size being updated?
+	bool updatingScrolledSize;
+	//! Is update of the scrolled size scheduled?
+	bool scrolledSizeUpdatePending;
 }; // class ScrollAreaPrivate
 
 } /* namespace QtMWidgets */
@@ -22,6 +22,8 @@ namespace QtMWidgets {
 class MinimumSizeLabel;
 class TextLabel;
 class TableViewCellLayout;
+class TableViewSectionLayout;
+class TableViewCanvas;
 
 
 //
@@ -59,7 +61,6 @@ public:
 	bool highlightOnClick;
 }; // class TableViewCellPrivate
 
-class RowsSeparator;
 
 //
 // TableViewSectionPrivate
@@ -73,6 +74,7 @@ public:
 		,	footer( 0 )
 		,	layout( 0 )
 		,	highlightCellOnClick( false )
+		,	updatesDepth( 0 )
 	{
 	}
 
@@ -81,14 +83,19 @@ public:
 	}
 
 	void init();
+	//! Start batch update.
+	void beginUpdates();
+	//! Finish batch update. \return Is the outermost batch finished?
+	bool endUpdates();
 
 	TableViewSection * q;
 	TextLabel * header;
 	TextLabel * footer;
 	QList< TableViewCell* > cells;
-	QVBoxLayout * layout;
-	QList< RowsSeparator* > separators;
+	TableViewSectionLayout * layout;
 	bool highlightCellOnClick;
+	//! Depth of nested batch updates.
+	int updatesDepth;
 }; // class TableViewSectionPrivate
 
 
@@ -105,6 +112,9 @@ public:
 		,	layout( 0 )
 		,	widget( 0 )
 		,	highlightCellOnClick( false )
+		,	dataSource( 0 )
+		,	canvas( 0 )
+		,	updatesDepth( 0 )
 	{
 	}
 
@@ -121,6 +131,12 @@ public:
 	QList< TableViewSection* > sections;
 	QWidget * widget;
 	bool highlightCellOnClick;
+	//! Data source.
+	TableViewDataSource * dataSource;
+	//! Widget with cells of the data source.
+	TableViewCanvas * canvas;
+	//! Depth of nested batch updates.
+	int updatesDepth;
 }; // class TableViewPrivate
 
 } /* namespace QtMWidgets */
@@ -0,0 +1,298 @@
+
+/*
+	SPDX-FileCopyrightText: 2014-2024 Igor Mironchik <igor.mironchik@gmail.com>
+	SPDX-License-Identifier: MIT
+*/
+
+// QtMWidgets include.
+#include "textindex.hpp"
+
+// C++ include.
+#include <algorithm>
+#include <limits>
+#include <vector>
+
+
+namespace QtMWidgets {
+
+//
+// TextIndex::Entry
+//
+
+TextIndex::Entry::Entry()
+	:	row( -1 )
+{
+}
+
+TextIndex::Entry::Entry( const QString & k, int r )
+	:	key( k )
+	,	row( r )
+{
+}
+
+bool
+TextIndex::Entry::operator < ( const Entry & other ) const
+{
+	return ( key < other.key || ( key == other.key && row < other.row ) );
+}
+
+
+//
+// TextIndex
+//
+
+TextIndex::TextIndex()
+	:	leaves( 0 )
+{
+}
+
+TextIndex::Entries
+TextIndex::build( const QStringList & texts )
+{
+	Entries result;
+	result.reserve( texts.size() );
+
+	for( int i = 0; i < texts.size(); ++i )
+		result.append( Entry( texts.at( i ).toCaseFolded(), i ) );
+
+	std::sort( result.begin(), result.end() );
+
+	return result;
+}
+
+const TextIndex::Entries &
+TextIndex::entries() const
+{
+	prepare();
+
+	return sorted;
+}
+
+void
+TextIndex::setEntries( const Entries & e )
+{
+	sorted = e;
+	added.clear();
+	tree.clear();
+}
+
+void
+TextIndex::clear()
+{
+	sorted.clear();
+	added.clear();
+	tree.clear();
+}
+
+int
+TextIndex::find( const QString & text, bool prefix,
+	Qt::CaseSensitivity cs, const RowText & rowText ) const
+{
+	prepare();
+
+	const QString key = text.toCaseFolded();
+
+	const auto first = std::lower_bound( sorted.cbegin(), sorted.cend(),
+		Entry( key, -1 ) );
+
+	// Matching keys are consecutive.
+	const auto last = ( prefix ?
+		std::partition_point( first, sorted.cend(),
+			[&key] ( const Entry & e ) { return e.key.startsWith( key ); } ) :
+		std::upper_bound( first, sorted.cend(),
+			Entry( key, std::numeric_limits< int >::max() ) ) );
+
+	const int lo = first - sorted.cbegin();
+	const int hi = last - sorted.cbegin();
+
+	if( lo >= hi )
+		return -1;
+
+	if( cs == Qt::CaseInsensitive )
+		return sorted.at( lowestRow( lo, hi ) ).row;
+
+	// Range of positions with the position of its lowest row.
+	struct Range {
+		int pos;
+		int lo;
+		int hi;
+	};
+
+	// Ranges are taken in order of their lowest rows, so the first
+	// matching candidate is the answer.
+	const auto greater = [this] ( const Range & r1, const Range & r2 )
+		{ return sorted.at( r1.pos ).row > sorted.at( r2.pos ).row; };
+
+	std::vector< Range > ranges;
+	ranges.push_back( { lowestRow( lo, hi ), lo, hi } );
+
+	while( !ranges.empty() )
+	{
+		std::pop_heap( ranges.begin(), ranges.end(), greater );
+		const Range r = ranges.back();
+		ranges.pop_back();
+
+		const int row = sorted.at( r.pos ).row;
+		const QString actual = rowText( row );
+
+		if( prefix ? actual.startsWith( text ) : actual == text )
+			return row;
+
+		if( r.lo < r.pos )
+		{
+			ranges.push_back( { lowestRow( r.lo, r.pos ), r.lo, r.pos } );
+			std::push_heap( ranges.begin(), ranges.end(), greater );
+		}
+
+		if( r.pos + 1 < r.hi )
+		{
+			ranges.push_back( { lowestRow( r.pos + 1, r.hi ), r.pos + 1, r.hi } );
+			std::push_heap( ranges.begin(), ranges.end(), greater );
+		}
+	}
+
+	return -1;
+}
+
+void
+TextIndex::insertRows( int start, const QStringList & texts )
+{
+	// Nothing to shift when rows are appended.
+	if( start < rowsCount() )
+		shiftRows( start, texts.size() );
+
+	addEntries( start, texts );
+}
+
+void
+TextIndex::removeRows( int start, int end )
+{
+	removeEntries( start, end );
+
+	shiftRows( end + 1, - ( end - start + 1 ) );
+}
+
+void
+TextIndex::updateRows( int start, const QStringList & texts )
+{
+	removeEntries( start, start + texts.size() - 1 );
+	addEntries( start, texts );
+}
+
+int
+TextIndex::rowsCount() const
+{
+	// Each row has one entry.
+	return sorted.size() + added.size();
+}
+
+void
+TextIndex::prepare() const
+{
+	if( !added.isEmpty() )
+	{
+		const int size = sorted.size();
+
+		std::sort( added.begin(), added.end() );
+		sorted.append( added );
+		added.clear();
+
+		std::inplace_merge( sorted.begin(), sorted.begin() + size, sorted.end() );
+
+		tree.clear();
+	}
+
+	if( tree.isEmpty() && !sorted.isEmpty() )
+	{
+		leaves = 1;
+
+		while( leaves < sorted.size() )
+			leaves *= 2;
+
+		tree.fill( -1, leaves * 2 );
+
+		for( int i = 0; i < sorted.size(); ++i )
+			tree[ leaves + i ] = i;
+
+		for( int i = leaves - 1; i > 0; --i )
+			tree[ i ] = lower( tree.at( i * 2 ), tree.at( i * 2 + 1 ) );
+	}
+}
+
+int
+TextIndex::lower( int p1, int p2 ) const
+{
+	if( p1 == -1 )
+		return p2;
+	else if( p2 == -1 )
+		return p1;
+	else
+		return ( sorted.at( p2 ).row < sorted.at( p1 ).row ? p2 : p1 );
+}
+
+int
+TextIndex::lowestRow( int node, int nodeLo, int nodeHi, int lo, int hi ) const
+{
+	if( lo <= nodeLo && nodeHi <= hi )
+		return tree.at( node );
+
+	const int middle = ( nodeLo + nodeHi ) / 2;
+
+	if( hi <= middle )
+		return lowestRow( node * 2, nodeLo, middle, lo, hi );
+	else if( lo >= middle )
+		return lowestRow( node * 2 + 1, middle, nodeHi, lo, hi );
+	else
+		return lower( lowestRow( node * 2, nodeLo, middle, lo, hi ),
+			lowestRow( node * 2 + 1, middle, nodeHi, lo, hi ) );
+}
+
+int
+TextIndex::lowestRow( int lo, int hi ) const
+{
+	return lowestRow( 1, 0, leaves, lo, hi );
+}
+
+void
+TextIndex::shiftRows( int start, int delta )
+{
+	// Order of rows is kept, so the tree stays valid.
+	for( Entry & e : sorted )
+	{
+		if( e.row >= start )
+			e.row += delta;
+	}
+
+	for( Entry & e : added )
+	{
+		if( e.row >= start )
+			e.row += delta;
+	}
+}
+
+void
+TextIndex::removeEntries( int start, int end )
+{
+	const auto removed = [start, end] ( const Entry & e )
+		{ return ( e.row >= start && e.row <= end ); };
+
+	added.erase( std::remove_if( added.begin(), added.end(), removed ),
+		added.end() );
+
+	const auto it = std::remove_if( sorted.begin(), sorted.end(), removed );
+
+	if( it != sorted.end() )
+	{
+		sorted.erase( it, sorted.end() );
+		tree.clear();
+	}
+}
+
+void
+TextIndex::addEntries( int start, const QStringList & texts )
+{
+	for( int i = 0; i < texts.size(); ++i )
+		added.append( Entry( texts.at( i ).toCaseFolded(), start + i ) );
+}
+
+} /* namespace QtMWidgets */
@@ -0,0 +1,124 @@
+
+/*
+	SPDX-FileCopyrightText: 2014-2024 Igor Mironchik <igor.mironchik@gmail.com>
+	SPDX-License-Identifier: MIT
+*/
+
+#ifndef QTMWIDGETS__PRIVATE__TEXTINDEX_HPP__INCLUDED
+#define QTMWIDGETS__PRIVATE__TEXTINDEX_HPP__INCLUDED
+
+// Qt include.
+#include <QString>
+#include <QStringList>
+#include <QVector>
+
+// C++ include.
+#include <functional>
+
+
+namespace QtMWidgets {
+
+//
+// TextIndex
+//
+
+/*!
+	Texts of the rows sorted by their case folded versions.
+
+	Exact and prefix lookups are binary searches. The lowest row
+	among the matching entries is taken from a segment tree over
+	the sorted entries, so a lookup is O(log n) however many
+	entries match. Keys are case folded, so case sensitive lookups
+	check candidates with the actual texts of the rows, in order
+	of rows.
+
+	Added entries are kept unsorted and merged on the next lookup,
+	so appending rows one at a time doesn't resort the index.
+*/
+class TextIndex {
+public:
+	//! Entry of the index.
+	class Entry {
+	public:
+		Entry();
+		Entry( const QString & k, int r );
+
+		bool operator < ( const Entry & other ) const;
+
+		//! Case folded text.
+		QString key;
+		//! Row.
+		int row;
+	}; // class Entry
+
+	typedef QVector< Entry > Entries;
+
+	//! Text of the row.
+	typedef std::function< QString ( int row ) > RowText;
+
+	TextIndex();
+
+	//! \return Sorted entries for \a texts of rows. Thread-safe.
+	static Entries build( const QStringList & texts );
+
+	//! \return Entries.
+	const Entries & entries() const;
+	//! Set sorted entries.
+	void setEntries( const Entries & e );
+	//! Clear.
+	void clear();
+
+	/*!
+		\return The lowest row with the given \a text, or with text
+		starting with \a text if \a prefix is true, or -1 if
+		there is no such row.
+	*/
+	int find( const QString & text, bool prefix,
+		Qt::CaseSensitivity cs, const RowText & rowText ) const;
+
+	//! Rows with \a texts were inserted at \a start.
+	void insertRows( int start, const QStringList & texts );
+	//! Rows from \a start to \a end were removed.
+	void removeRows( int start, int end );
+	//! Texts of rows starting from \a start were changed to \a texts.
+	void updateRows( int start, const QStringList & texts );
+
+private:
+	//! \return Count of rows.
+	int rowsCount() const;
+	//! Merge added entries and build the tree if needed.
+	void prepare() const;
+	//! \return Position of the entry with the lower row of the two.
+	int lower( int p1, int p2 ) const;
+	/*!
+		\return Position of the entry with the lowest row among
+		positions from \a lo to \a hi, not including \a hi, in
+		the \a node covering positions from \a nodeLo to \a nodeHi.
+	*/
+	int lowestRow( int node, int nodeLo, int nodeHi, int lo, int hi ) const;
+	//! \return Position of the entry with the lowest row in [ \a lo, \a hi ).
+	int lowestRow( int lo, int hi ) const;
+	//! Shift rows starting from \a start on \a delta.
+	void shiftRows( int start, int delta );
+	//! Remove entries of rows from \a start to \a end.
+	void removeEntries( int start, int end );
+	//! Add entries for \a texts of rows starting from \a start.
+	void addEntries( int start, const QStringList & texts );
+
+	//! Sorted entries.
+	mutable Entries sorted;
+	//! Added entries not merged into the sorted ones yet.
+	mutable Entries added;
+	/*!
+		Segment tree over the sorted entries, node holds position
+		of the entry with the lowest row in its range. Empty when
+		it should be built.
+	*/
+	mutable QVector< int > tree;
+	//! Count of leaves in the tree, power of two.
+	mutable int leaves;
+}; // class TextIndex
+
+} /* namespace QtMWidgets */
+
+#endif // QTMWIDGETS__PRIVATE__TEXTINDEX_HPP__INCLUDED
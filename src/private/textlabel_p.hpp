@@ -0,0 +1,179 @@
+
+/*
+	SPDX-FileCopyrightText: 2014-2024 Igor Mironchik <igor.mironchik@gmail.com>
+	SPDX-License-Identifier: MIT
+*/
+
+#ifndef QTMWIDGETS__PRIVATE__TEXTLABEL_P_HPP__INCLUDED
+#define QTMWIDGETS__PRIVATE__TEXTLABEL_P_HPP__INCLUDED
+
+// QtMWidgets include.
+#include "../textlabel.hpp"
+
+// Qt include.
+#include <QStaticText>
+#include <QTextLayout>
+#include <QHash>
+#include <QVector>
+#include <QCache>
+#include <QFutureWatcher>
+
+
+namespace QtMWidgets {
+
+//
+// TextLine
+//
+
+//! Line of the laid out plain text.
+struct TextLine {
+	//! Position of the first character in the text.
+	int start;
+	//! Count of characters.
+	int length;
+	qreal y;
+	qreal height;
+	qreal ascent;
+	//! Width of the text in the line.
+	qreal width;
+}; // struct TextLine
+
+
+//
+// TextLayout
+//
+
+//! Plain text laid out in the background.
+struct TextLayout {
+	TextLayout()
+		:	generation( -1 )
+		,	width( -1 )
+		,	textWidth( 0.0 )
+		,	paragraphs( false )
+	{
+	}
+
+	//! Generation of the text.
+	int generation;
+	//! Width of the label.
+	int width;
+	//! Width lines were broken to.
+	qreal textWidth;
+	//! Text with line separators, or with new lines if split into paragraphs.
+	QString text;
+	QVector< TextLine > lines;
+	//! Is text split into paragraphs instead of lines?
+	bool paragraphs;
+	//! Positions of blocks in the text: paragraphs, long ones are split.
+	QVector< int > paragraphStarts;
+	//! Bottoms of blocks.
+	QVector< qreal > paragraphBottoms;
+	//! Size of the text.
+	QSizeF size;
+}; // struct TextLayout
+
+
+//
+// TextLabelPrivate
+//
+
+class TextLabelPrivate {
+public:
+	TextLabelPrivate( TextLabel * parent )
+		:	q( parent )
+		,	margin( 0 )
+		,	asyncLayout( false )
+		,	virtualizedParagraphs( false )
+		,	generation( 0 )
+		,	pendingWidth( -1 )
+		,	pendingProbeWidth( -1 )
+		,	layoutWatcher( 0 )
+		,	probeWatcher( 0 )
+	{
+	}
+
+	//! \return Private data of the \a label.
+	static TextLabelPrivate * get( TextLabel * label )
+	{
+		return label->d.data();
+	}
+
+	void init();
+	//! \return Can text be laid out without QTextDocument?
+	bool isPlainText() const;
+	//! \return Is text laid out in the background?
+	bool isAsyncLayout() const;
+	//! \return Is text laid out and drawn by paragraphs?
+	bool isParagraphLayout() const;
+	//! \return Text with line separators instead of new lines.
+	QString plainText() const;
+	//! \return Width of the text for the given width of the label.
+	qreal textWidth( int w ) const;
+	//! \return Size of the text laid out in the given width.
+	QSizeF textSize( qreal width ) const;
+	//! \return Height of the label for the given size of the text.
+	int labelHeight( qreal textHeight ) const;
+	//! \return Height of the label for the laid out text.
+	int layoutHeight( const TextLayout & l ) const;
+	//! Forget cached sizes.
+	void invalidateSizes();
+	//! Cancel layout in the background.
+	void cancelLayout();
+	//! Cache height for the width.
+	void cacheHeight( int w, int height ) const;
+	/*!
+		Start laying out the text in the background for the label's width \a w.
+		Layout for other width than the label's one is a probe of the height,
+		it doesn't cancel layout for the label's width.
+	*/
+	void startLayout( int w );
+	//! Run layout for the width \a w with \a watcher, superseded one is canceled.
+	void runLayout( QFutureWatcher< TextLayout > * & watcher, int w );
+	//! \return Layout prepared for the label's width \a w.
+	TextLayout prepareLayout( int w ) const;
+	//! Set shown layout.
+	void setLayout( const TextLayout & l );
+	//! Lay out paragraphs for the label's width \a w.
+	void layoutParagraphs( int w );
+	//! \return Lines of the block.
+	const QTextLayout * paragraphLayout( int i ) const;
+	//! \return Estimated height for the width while text is laid out.
+	int estimatedHeight( int w ) const;
+	//! Draw lines of the laid out text intersecting \a clip.
+	void drawLayout( QPainter * p, const QPoint & topLeft,
+		const QRect & clip ) const;
+	//! Draw paragraphs intersecting \a clip.
+	void drawParagraphs( QPainter * p, const QPoint & topLeft,
+		const QRect & clip ) const;
+
+	TextLabel * q;
+	QStaticText staticText;
+	int margin;
+	QColor color;
+	//! Cached heights for widths.
+	mutable QHash< int, int > heights;
+	//! Cached minimum size hint.
+	mutable QSize minimumSize;
+	//! Lay out the text in the background?
+	bool asyncLayout;
+	//! Lay out and draw only visible paragraphs?
+	bool virtualizedParagraphs;
+	//! Incremented on each change of the text or its format.
+	int generation;
+	//! Width of the label being laid out in the background.
+	int pendingWidth;
+	//! Other width being laid out in the background for the height.
+	int pendingProbeWidth;
+	//! Text laid out in the background and shown.
+	TextLayout layout;
+	//! Watcher of the background layout for the label's width.
+	QFutureWatcher< TextLayout > * layoutWatcher;
+	//! Watcher of the background layout for other width.
+	QFutureWatcher< TextLayout > * probeWatcher;
+	//! Lines of recently drawn paragraphs.
+	mutable QCache< int, QTextLayout > paragraphLayouts;
+}; // class TextLabelPrivate
+
+} /* namespace QtMWidgets */
+
+#endif // QTMWIDGETS__PRIVATE__TEXTLABEL_P_HPP__INCLUDED
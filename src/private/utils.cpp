@@ -7,47 +7,177 @@
 // QtMWidgets include.
 #include "utils.hpp"
 
+// Qt include.
+#include <QFontMetrics>
+#include <QTextLayout>
+#include <QCache>
+#include <QHashFunctions>
+#include <QPaintDevice>
+
+// C++ include.
+#include <functional>
+
 
 namespace QtMWidgets {
 
-QString
-accomodateString( const QString & text, const QRect & r,
-	int flags, const QStyleOption & opt )
+//! Maximum number of cached elided strings.
+static const int maxElidedStrings = 1000;
+
+
+//
+// ElidedStringKey
+//
+
+//! Key of the elided strings cache.
+class ElidedStringKey {
+public:
+	ElidedStringKey( const QString & t, int w, int f, const QFont & font,
+		const QPaintDevice * device )
+		:	text( t )
+		,	width( w )
+		,	flags( f )
+		,	fontKey( font.key() )
+		,	dpi( device ? device->logicalDpiY() : 0 )
+	{
+	}
+
+	bool operator == ( const ElidedStringKey & other ) const
+	{
+		return ( width == other.width && flags == other.flags &&
+			dpi == other.dpi && text == other.text &&
+			fontKey == other.fontKey );
+	}
+
+	//! Text.
+	QString text;
+	//! Available width.
+	int width;
+	//! Flags.
+	int flags;
+	//! Key of the font.
+	QString fontKey;
+	//! Logical DPI of the device, 0 for the screen.
+	int dpi;
+}; // class ElidedStringKey
+
+inline size_t
+qHash( const ElidedStringKey & key, size_t seed = 0 )
+{
+	return qHashMulti( seed, key.text, key.width, key.flags, key.fontKey,
+		key.dpi );
+}
+
+//! \return Cache of elided strings.
+static QCache< ElidedStringKey, QString > &
+elidedStrings()
+{
+	static QCache< ElidedStringKey, QString > cache( maxElidedStrings );
+
+	return cache;
+}
+
+
+//
+// elideString
+//
+
+static QString
+elideString( const QString & text, const QRect & r, int flags,
+	const QFont & font, const QPaintDevice * device )
 {
-	const QRect & b = opt.fontMetrics.boundingRect( r, flags, text );
+	// Font is resolved for the device as the painter does.
+	const QFontMetrics fm( font, device );
+	QTextLayout layout( QString(), font, device );
 
-	QString res = text;
+	// Width of the text from position "from" till "to".
+	std::function< int ( int, int ) > width;
 
-	if( b.width() > r.width() )
+	if( flags & ( Qt::TextShowMnemonic | Qt::TextHideMnemonic ) &&
+		text.contains( QLatin1Char( '&' ) ) )
 	{
-		int w = 0;
-		int x = 0;
+		// Mnemonics aren't drawn, so text is measured as it's drawn.
+		width = [&] ( int from, int to )
+			{ return fm.boundingRect( r, flags, text.mid( from, to - from ) ).width(); };
+	}
+	else
+	{
+		// Cumulative advances of the single layout.
+		layout.setText( text );
+		layout.beginLayout();
+		QTextLine line = layout.createLine();
+		line.setNumColumns( text.length() );
+		layout.endLayout();
+
+		width = [line] ( int from, int to )
+			{ return qRound( qAbs( line.cursorToX( to ) - line.cursorToX( from ) ) ); };
+	}
 
-		res.clear();
+	const int length = text.length();
 
-		while( w <= ( r.width() ) / 2 )
-		{
-			res.append( text.at( x ) );
-			++x;
-			w = opt.fontMetrics.boundingRect( r, flags, res ).width();
-		}
+	if( width( 0, length ) <= r.width() )
+		return text;
 
-		res.append( QStringLiteral( "..." ) );
+	// Don't cut surrogate pairs.
+	auto snap = [&text, length] ( int pos )
+		{ return ( pos > 0 && pos < length && text.at( pos ).isLowSurrogate() ?
+			pos + 1 : pos ); };
 
-		x = text.length() - 1;
+	// The shortest head wider than the half of available width.
+	int low = 1;
+	int high = length;
 
-		QString tmp = text.at( x );
+	while( low < high )
+	{
+		const int middle = ( low + high ) / 2;
+
+		if( width( 0, middle ) > r.width() / 2 )
+			high = middle;
+		else
+			low = middle + 1;
+	}
 
-		while( opt.fontMetrics.boundingRect( r, flags, res + tmp ).width() <= r.width() )
-		{
-			--x;
-			tmp.prepend( text.at( x ) );
-		}
+	const int head = snap( low );
+	const QString ellipsis = QStringLiteral( "..." );
+	const int used = width( 0, head ) + fm.horizontalAdvance( ellipsis );
 
-		res.append( text.right( text.length() - x - 1 ) );
+	// The longest tail that fits the rest.
+	low = head;
+	high = length;
+
+	while( low < high )
+	{
+		const int middle = ( low + high ) / 2;
+
+		if( used + width( middle, length ) <= r.width() )
+			high = middle;
+		else
+			low = middle + 1;
 	}
 
-	return res;
+	const int tail = snap( low );
+
+	return text.left( head ) + ellipsis + text.mid( tail );
+}
+
+
+//
+// accomodateString
+//
+
+QString
+accomodateString( const QString & text, const QRect & r,
+	int flags, const QFont & font, const QPaintDevice * device )
+{
+	const ElidedStringKey key( text, r.width(), flags, font, device );
+
+	if( const QString * cached = elidedStrings().object( key ) )
+		return *cached;
+
+	const QString result = elideString( text, r, flags, font, device );
+
+	elidedStrings().insert( key, new QString( result ) );
+
+	return result;
 }
 
 } /* namespace QtMWidgets */
@@ -9,15 +9,28 @@
 
 // Qt include.
 #include <QString>
-#include <QStyleOption>
+#include <QFont>
 #include <QRect>
 
+QT_BEGIN_NAMESPACE
+class QPaintDevice;
+QT_END_NAMESPACE
+
 
 namespace QtMWidgets {
 
+/*!
+	\return \a text elided in the middle to fit the width of \a r
+	when drawn with \a font and \a flags on the \a device.
+
+	Text is measured with metrics of the \a device, the painter
+	uses them, or of the screen if \a device is 0.
+
+	Results are cached, should be called from the GUI thread.
+*/
 QString
 accomodateString( const QString & text, const QRect & r,
-	int flags, const QStyleOption & opt );
+	int flags, const QFont & font, const QPaintDevice * device = 0 );
 
 } /* namespace QtMWidgets */
 
@@ -6,10 +6,13 @@
 
 // QtMWidgets include.
 #include "progressbar.hpp"
+#include "private/animationtimer.hpp"
 
 // Qt include.
 #include <QPainter>
 #include <QVariantAnimation>
+#include <QRegion>
+#include <QAtomicInt>
 #ifndef QT_NO_ACCESSIBILITY
 #include <QAccessible>
 #endif
@@ -17,6 +20,10 @@
 
 namespace QtMWidgets {
 
+//! Interval of publishing posted values in milliseconds.
+static const int postedValueInterval = 16;
+
+
 //
 // ProgressBarPrivate
 //
@@ -34,6 +41,9 @@ public:
 		,	grooveHeight( 3 )
 		,	animation( 0 )
 		,	animate( true )
+		,	postedValue( 0 )
+		,	valuePosted( 0 )
+		,	postTimer( 0 )
 	{
 	}
 
@@ -43,6 +53,12 @@ public:
 	bool repaintRequired() const;
 	//! \return Groove rect.
 	QRect grooveRect() const;
+	//! Calculate rects of the busy animation for the \a value.
+	void animationRects( double value, QRect & a1, QRect & a2 ) const;
+	//! \return Offset of the \a value in the groove.
+	int valueOffset( int value ) const;
+	//! \return Rect of the groove between values \a from and \a to.
+	QRect grooveSegment( int from, int to ) const;
 
 	//! Parent;
 	ProgressBar * q;
@@ -70,6 +86,14 @@ public:
 	QVariantAnimation * animation;
 	//! Need paint animation?
 	bool animate;
+	//! Region of the busy animation painted last time.
+	QRegion animationRegion;
+	//! Last posted value.
+	QAtomicInt postedValue;
+	//! Is posted value waiting for publishing?
+	QAtomicInt valuePosted;
+	//! Timer of publishing posted values.
+	AnimationTimer * postTimer;
 }; // class ProgressBarPrivate
 
 void
@@ -91,6 +115,9 @@ ProgressBarPrivate::init()
 	animation->setStartValue( 0.0 );
 	animation->setEndValue( 1.0 );
 	animation->start();
+
+	postTimer = new AnimationTimer( q );
+	postTimer->setSingleShot( true );
 }
 
 bool
@@ -116,6 +143,61 @@ ProgressBarPrivate::grooveRect() const
 	return q->rect();
 }
 
+int
+ProgressBarPrivate::valueOffset( int v ) const
+{
+	const QRect r = grooveRect();
+
+	return (qreal) v / (qreal) ( maximum - minimum ) *
+		( orientation == Qt::Horizontal ? r.width() : r.height() );
+}
+
+QRect
+ProgressBarPrivate::grooveSegment( int from, int to ) const
+{
+	const QRect r = grooveRect();
+
+	if( maximum == minimum )
+		return r;
+
+	const int o1 = valueOffset( from );
+	const int o2 = valueOffset( to );
+
+	// One pixel around for the pen and rounding.
+	const int start = qMin( o1, o2 ) - 1;
+	const int length = qAbs( o1 - o2 ) + 3;
+
+	if( orientation == Qt::Horizontal )
+		return QRect( ( invertedAppearance ? r.x() + r.width() - start - length :
+			r.x() + start ), r.y(), length, r.height() );
+	else
+		return QRect( r.x(), ( invertedAppearance ?
+			r.y() + r.height() - start - length : r.y() + start ),
+			r.width(), length );
+}
+
+void
+ProgressBarPrivate::animationRects( double value, QRect & a1, QRect & a2 ) const
+{
+	const QRect r = grooveRect();
+
+	a1 = QRect(
+		( orientation == Qt::Horizontal ?
+			r.x() + r.width() * value / 3.0 + grooveHeight :
+			r.x() ),
+		( orientation == Qt::Horizontal ? r.y() :
+			r.y() + r.height() * value / 3.0 + grooveHeight ),
+		grooveHeight, grooveHeight );
+
+	a2 = QRect(
+		( orientation == Qt::Horizontal ?
+			r.x() + r.width() * value / 1.5 + r.width() / 3 :
+			r.x() ),
+		( orientation == Qt::Horizontal ? r.y() :
+			r.y() + r.height() * value / 1.5 + r.height() / 3 ),
+		grooveHeight, grooveHeight );
+}
+
 
 //
 // ProgressBar
@@ -129,6 +211,8 @@ ProgressBar::ProgressBar( QWidget * parent )
 
 	connect( d->animation, &QVariantAnimation::valueChanged,
 		this, &ProgressBar::_q_animation );
+	connect( d->postTimer, &AnimationTimer::timeout,
+		this, &ProgressBar::_q_postedValue );
 }
 
 ProgressBar::~ProgressBar()
@@ -314,16 +398,31 @@ ProgressBar::setValue( int value )
 	}
 #endif
 
-	if( d->repaintRequired() )
-		repaint();
-
 	if( d->animate )
 	{
 		d->animate = false;
 
 		d->animation->stop();
 
-		repaint();
+		update();
+	}
+	// Only the groove between painted and new values is repainted.
+	else if( d->repaintRequired() )
+		update( d->grooveSegment( d->lastPaintedValue, d->value ) );
+}
+
+void
+ProgressBar::postValue( int value )
+{
+	d->postedValue.storeRelease( value );
+
+	if( d->valuePosted.testAndSetOrdered( 0, 1 ) )
+	{
+		QMetaObject::invokeMethod( this, [this] ()
+			{
+				if( !d->postTimer->isActive() )
+					d->postTimer->start( postedValueInterval );
+			}, Qt::QueuedConnection );
 	}
 }
 
@@ -354,8 +453,7 @@ ProgressBar::paintEvent( QPaintEvent * )
 	{
 		d->lastPaintedValue = d->value;
 
-		const int offset = (qreal) d->value / (qreal) ( d->maximum - d->minimum ) *
-			( d->orientation == Qt::Horizontal ? r.width() : r.height() );
+		const int offset = d->valueOffset( d->value );
 
 		const int x = ( ( d->orientation == Qt::Horizontal && d->invertedAppearance ) ?
 			r.x() + r.width() - offset - 1 : 0 );
@@ -396,21 +494,8 @@ ProgressBar::paintEvent( QPaintEvent * )
 
 		p.drawRect( r );
 
-		const QRect a1(
-			( d->orientation == Qt::Horizontal ?
-				r.x() + r.width() * value / 3.0 + d->grooveHeight :
-				r.x() ),
-			( d->orientation == Qt::Horizontal ? r.y() :
-				r.y() + r.height() * value / 3.0 + d->grooveHeight ),
-			d->grooveHeight, d->grooveHeight );
-
-		const QRect a2(
-			( d->orientation == Qt::Horizontal ?
-				r.x() + r.width() * value / 1.5 + r.width() / 3 :
-				r.x() ),
-			( d->orientation == Qt::Horizontal ? r.y() :
-				r.y() + r.height() * value / 1.5 + r.height() / 3 ),
-			d->grooveHeight, d->grooveHeight );
+		QRect a1, a2;
+		d->animationRects( value, a1, a2 );
 
 		p.setPen( d->animationColor );
 		p.setBrush( d->animationColor );
@@ -423,9 +508,27 @@ ProgressBar::paintEvent( QPaintEvent * )
 void
 ProgressBar::_q_animation( const QVariant & value )
 {
-	Q_UNUSED( value )
+	QRect a1, a2;
+	d->animationRects( value.toDouble(), a1, a2 );
 
-	update();
+	// Rects are drawn with the pen, so they are one pixel bigger.
+	const QRegion region = QRegion( a1.adjusted( 0, 0, 1, 1 ) ) +
+		a2.adjusted( 0, 0, 1, 1 );
+
+	// Only the moved dots are repainted.
+	update( d->animationRegion + region );
+
+	d->animationRegion = region;
+}
+
+void
+ProgressBar::_q_postedValue()
+{
+	// Values posted after this point will be published with the next frame.
+	// Full barrier, so the flag is cleared before the value is read.
+	d->valuePosted.fetchAndStoreOrdered( 0 );
+
+	setValue( d->postedValue.loadAcquire() );
 }
 
 } /* namespace QtMWidgets */
@@ -163,6 +163,15 @@ public:
 	//! Set groove color.
 	void setGrooveColor( const QColor & c );
 
+	/*!
+		Set current value from any thread.
+
+		Values are published to the GUI thread at most once per
+		frame, the last posted value wins. Use it to report progress
+		of workers that may update the value very often.
+	*/
+	void postValue( int value );
+
 	QSize sizeHint() const override;
 	QSize minimumSizeHint() const override;
 
@@ -188,6 +197,7 @@ protected:
 
 private slots:
 	void _q_animation( const QVariant & value );
+	void _q_postedValue();
 
 private:
 	Q_DISABLE_COPY( ProgressBar )
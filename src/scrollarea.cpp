@@ -47,18 +47,34 @@ ScrollAreaPrivate::updateScrolledSize()
 	if( !widget )
 		return;
 
+	updatingScrolledSize = true;
+
+	if( !sizesValid )
+	{
+		minSize = qSmartMinSize( widget );
+		maxSize = qSmartMaxSize( widget );
+		hfwWidth = -1;
+		sizesValid = true;
+	}
+
 	QSize p = viewport->size();
 
-	QSize min = qSmartMinSize( widget );
-	QSize max = qSmartMaxSize( widget );
+	QSize min = minSize;
+	QSize max = maxSize;
 
 	if( resizable )
 	{
 		if( ( widget->layout() ? widget->layout()->hasHeightForWidth() : widget->sizePolicy().hasHeightForWidth() ) )
 		{
 			QSize p_hfw = p.boundedTo( max );
-			int h = widget->heightForWidth( p_hfw.width() );
-			min = QSize( p_hfw.width(), qMax( p.height(), h ) );
+
+			if( hfwWidth != p_hfw.width() )
+			{
+				hfwHeight = widget->heightForWidth( p_hfw.width() );
+				hfwWidth = p_hfw.width();
+			}
+
+			min = QSize( p_hfw.width(), qMax( p.height(), hfwHeight ) );
 		}
 
 		widget->resize( p.expandedTo( min ).boundedTo( max ) );
@@ -67,6 +83,30 @@ ScrollAreaPrivate::updateScrolledSize()
 	q->setScrolledAreaSize( widget->size() );
 
 	updateWidgetPosition();
+
+	updatingScrolledSize = false;
+}
+
+void
+ScrollAreaPrivate::invalidateSizes()
+{
+	sizesValid = false;
+	hfwWidth = -1;
+}
+
+void
+ScrollAreaPrivate::scheduleScrolledSizeUpdate()
+{
+	if( scrolledSizeUpdatePending )
+		return;
+
+	scrolledSizeUpdatePending = true;
+
+	QMetaObject::invokeMethod( q, [this] ()
+		{
+			scrolledSizeUpdatePending = false;
+			updateScrolledSize();
+		}, Qt::QueuedConnection );
 }
 
 
@@ -79,6 +119,8 @@ ScrollArea::ScrollArea( QWidget * parent )
 {
 	ScrollAreaPrivate * d = d_func();
 	d->viewport->setBackgroundRole( QPalette::NoRole );
+	// Geometry changes of the widget without layout are posted to the viewport.
+	d->viewport->installEventFilter( this );
 }
 
 ScrollArea::ScrollArea( ScrollAreaPrivate * dd, QWidget * parent )
@@ -86,6 +128,7 @@ ScrollArea::ScrollArea( ScrollAreaPrivate * dd, QWidget * parent )
 {
 	ScrollAreaPrivate * d = d_func();
 	d->viewport->setBackgroundRole( QPalette::NoRole );
+	d->viewport->installEventFilter( this );
 }
 
 ScrollArea::~ScrollArea()
@@ -126,6 +169,7 @@ ScrollArea::setWidget( QWidget * widget )
 	d->vertBlur->setParent( d->widget );
 	d->widget->setAutoFillBackground( true );
 	widget->installEventFilter( this );
+	d->invalidateSizes();
 	d->updateScrolledSize();
 	d->widget->show();
 }
@@ -141,6 +185,7 @@ ScrollArea::takeWidget()
 	d->horBlur->setParent( d->viewport );
 	d->vertBlur->setParent( d->viewport );
 	d->widget = 0;
+	d->invalidateSizes();
 	if( w )
 		w->setParent( 0 );
 	return w;
@@ -162,6 +207,7 @@ ScrollArea::setWidgetResizable( bool resizable )
 	{
 		d->resizable = resizable;
 		updateGeometry();
+		d->invalidateSizes();
 		d->updateScrolledSize();
 	}
 }
@@ -297,8 +343,34 @@ ScrollArea::eventFilter( QObject * o, QEvent * e )
 {
 	ScrollAreaPrivate * d = d_func();
 
-	if( o == d->widget && e->type() == QEvent::Resize )
-		d->updateScrolledSize();
+	if( o == d->widget || o == d->viewport )
+	{
+		switch( e->type() )
+		{
+			case QEvent::Resize :
+			{
+				// Own resizes of the widget are already handled.
+				if( o == d->widget && !d->updatingScrolledSize )
+				{
+					d->invalidateSizes();
+					d->updateScrolledSize();
+				}
+			}
+			break;
+
+			case QEvent::LayoutRequest :
+			{
+				// Several requests in one event loop iteration
+				// lead to one update.
+				d->invalidateSizes();
+				d->scheduleScrolledSizeUpdate();
+			}
+			break;
+
+			default :
+			break;
+		}
+	}
 
 	return AbstractScrollArea::eventFilter( o, e );
 }
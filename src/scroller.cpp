@@ -7,11 +7,11 @@
 // QtMWidgets include.
 #include "scroller.hpp"
 #include "fingergeometry.hpp"
+#include "virtualclock.hpp"
 
 // Qt include.
 #include <QEvent>
 #include <QMouseEvent>
-#include <QElapsedTimer>
 #include <QVariantAnimation>
 
 
@@ -48,7 +48,7 @@ public:
 	uint maxVelocity;
 	uint startDragDistance;
 	QEasingCurve scrollingCurve;
-	QElapsedTimer elapsed;
+	ElapsedTimer elapsed;
 	QPoint pos;
 	uint scrollTime;
 	qreal xVelocity;
@@ -243,7 +243,7 @@ Scroller::eventFilter( QObject * obj, QEvent * event )
 
 				d->pos = e->pos();
 
-				if( p.manhattanLength() > 5 )
+				if( p.manhattanLength() > 5 && time > 0.0 )
 				{
 					d->xVelocity = (qreal) p.x() / time;
 					d->yVelocity = (qreal) p.y() / time;
@@ -8,13 +8,13 @@
 #include "stepper.hpp"
 #include "fingergeometry.hpp"
 #include "color.hpp"
+#include "private/animationtimer.hpp"
 
 // Qt include.
 #include <QPainter>
 #include <QMouseEvent>
 #include <QPainterPath>
 #include <QStyleOption>
-#include <QTimer>
 
 
 namespace QtMWidgets {
@@ -91,7 +91,7 @@ public:
 	//! Pressed button.
 	Button button;
 	//! Timer.
-	QTimer * timer;
+	AnimationTimer * timer;
 	//! Autorepeat timeout.
 	int timeout;
 	//! Autorepeat count.
@@ -119,7 +119,7 @@ StepperPrivate::init()
 
 	color = opt.palette.color( QPalette::Highlight );
 
-	timer = new QTimer( q );
+	timer = new AnimationTimer( q );
 }
 
 void
@@ -221,7 +221,7 @@ Stepper::Stepper( QWidget * parent )
 {
 	setSizePolicy( QSizePolicy( QSizePolicy::Fixed, QSizePolicy::Fixed ) );
 
-	connect( d->timer, &QTimer::timeout,
+	connect( d->timer, &AnimationTimer::timeout,
 		this, &Stepper::_q_autorepeat );
 }
 
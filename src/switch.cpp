@@ -8,6 +8,7 @@
 #include "switch.hpp"
 #include "color.hpp"
 #include "private/drawing.hpp"
+#include "private/palettecolors.hpp"
 #include "fingergeometry.hpp"
 
 // Qt include.
@@ -57,6 +58,8 @@ public:
 	int mouseMoveDelta;
 	bool leftMouseButtonPressed;
 	QPoint mousePos;
+	//! Shades of the palette's colors.
+	QSharedPointer< const PaletteColors > colors;
 }; // class SwitchPrivate
 
 bool
@@ -310,11 +313,14 @@ Switch::paintEvent( QPaintEvent * )
 		case NotAcceptedUncheck :
 		case AcceptedUncheck :
 		{
+			const PaletteColors & colors =
+				PaletteColors::cached( d->colors, opt.palette );
+
 			QLinearGradient g( QPointF( 0.0, 0.0 ), QPointF( 0.0, 1.0 ) );
 			g.setCoordinateMode( QGradient::ObjectBoundingMode );
-			g.setColorAt( 0.0, darkerColor( lightColor, 75 ) );
-			g.setColorAt( 0.1, darkerColor( lightColor, 25 ) );
-			g.setColorAt( 1.0, darkerColor( lightColor, 10 ) );
+			g.setColorAt( 0.0, colors.shade( QPalette::Base, -75 ) );
+			g.setColorAt( 0.1, colors.shade( QPalette::Base, -25 ) );
+			g.setColorAt( 1.0, colors.shade( QPalette::Base, -10 ) );
 
 			p.setBrush( g );
 		}
@@ -357,6 +363,25 @@ Switch::paintEvent( QPaintEvent * )
 			d->radius, d->radius, borderColor, lightColor );
 }
 
+void
+Switch::changeEvent( QEvent * event )
+{
+	switch( event->type() )
+	{
+		case QEvent::PaletteChange :
+		case QEvent::EnabledChange :
+		case QEvent::ActivationChange :
+		case QEvent::StyleChange :
+			d->colors.clear();
+		break;
+
+		default :
+			break;
+	}
+
+	QWidget::changeEvent( event );
+}
+
 void
 Switch::mousePressEvent( QMouseEvent * event )
 {
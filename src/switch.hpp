@@ -176,6 +176,7 @@ protected:
 	void mousePressEvent( QMouseEvent * event ) override;
 	void mouseReleaseEvent( QMouseEvent * event ) override;
 	void mouseMoveEvent( QMouseEvent * event ) override;
+	void changeEvent( QEvent * event ) override;
 
 private:
 	friend class SwitchPrivate;
@@ -17,6 +17,11 @@
 #include <QMouseEvent>
 #include <QPainter>
 #include <QPicture>
+#include <QHash>
+#include <QVector>
+
+// C++ include.
+#include <algorithm>
 
 
 namespace QtMWidgets {
@@ -554,319 +559,1352 @@ TableViewCell::mouseReleaseEvent( QMouseEvent * e )
 
 
 //
-// TableViewSectionPrivate
+// TableViewSectionLayout
 //
 
-void
-TableViewSectionPrivate::init()
-{
-	q->setSizePolicy( QSizePolicy::Minimum, QSizePolicy::Fixed );
-	q->setBackgroundRole( QPalette::Base );
-	q->setAutoFillBackground( true );
-
-	layout = new QVBoxLayout( q );
-	layout->setSpacing( 0 );
-	layout->setContentsMargins( 0, 0, 0, 0 );
-
-	QSizePolicy sp( QSizePolicy::Minimum, QSizePolicy::Fixed );
-	sp.setHeightForWidth( true );
-
-	header = new TextLabel( q );
-	header->setBackgroundRole( QPalette::Midlight );
-	header->setAutoFillBackground( true );
-	header->setMargin( 11 );
-	header->setSizePolicy( sp );
-	layout->addWidget( header );
-
-	footer = new TextLabel( q );
-	QFont font = footer->font();
-	font.setPointSize( qMax( font.pointSize() - 1, 5 ) );
-	footer->setFont( font );
-	footer->setBackgroundRole( QPalette::Midlight );
-	footer->setAutoFillBackground( true );
-	footer->setMargin( 11 );
-	footer->setSizePolicy( sp );
-	layout->addWidget( footer );
-}
+//! Indent of the line separating rows.
+static const int separatorIndent = 11;
 
+/*!
+	Layout of the TableViewSection: header, cells separated by
+	one pixel lines and footer, one above the other.
 
-//
-// RowsSeparator
-//
+	Sizes of items are kept for the current width, so inserting
+	or removing a cell measures only this cell, and geometry is set
+	only for items that moved. Separators are painted by the section.
 
-class RowsSeparator
-	:	public QWidget
+	A cell is measured again when it requests layout, is shown or
+	hidden, or its font, style or contents margins change. Header
+	and footer cache their heights themselves, so they are asked on
+	every invalidation.
+*/
+class TableViewSectionLayout
+	:	public QLayout
 {
 public:
-	RowsSeparator( QWidget * parent = 0 )
-		:	QWidget( parent )
-	{
-		setSizePolicy( QSizePolicy::Expanding, QSizePolicy::Fixed );
-	}
-
-	QSize sizeHint() const override
-	{
-		return QSize( 1, 1 );
-	}
+	explicit TableViewSectionLayout( QWidget * parent );
+	virtual ~TableViewSectionLayout();
+
+	void setHeader( TextLabel * label );
+	void setFooter( TextLabel * label );
+	//! Insert cell at the given position among cells.
+	void insertCell( int index, TableViewCell * cell );
+	//! Remove cell without invalidating heights of other items.
+	void removeCell( TableViewCell * cell );
+	//! \return Rectangles of separators between cells.
+	QVector< QRect > separators() const;
 
-protected:
-	void paintEvent( QPaintEvent * ) override
-	{
-		QPainter p( this );
+	void addItem( QLayoutItem * item ) override;
+	int count() const override;
+	QLayoutItem * itemAt( int index ) const override;
+	QLayoutItem * takeAt( int index ) override;
+	void setGeometry( const QRect & rect ) override;
+	void invalidate() override;
+	Qt::Orientations expandingDirections() const override;
+	bool hasHeightForWidth() const override;
+	int heightForWidth( int w ) const override;
 
-		p.setPen( palette().color( QPalette::Midlight ) );
-		p.drawLine( 11, 0, width(), 0 );
-	}
-}; // class RowsSeparator
+	QSize minimumSize() const override;
+	QSize sizeHint() const override;
 
+	bool eventFilter( QObject * o, QEvent * e ) override;
 
-//
-// TableViewSection
-//
+private:
+	//! \return Is item with the given index a cell?
+	bool isCell( int index ) const;
+	//! Measure unknown heights of items for the width \a w.
+	void updateHeights( int w ) const;
+	//! \return Height of all items for the width \a w.
+	int totalHeight( int w ) const;
+	//! Size of the layout by sizes of items.
+	QSize size( bool minimum ) const;
+	//! Forget sizes of the layout, but keep heights of items.
+	void itemsChanged();
+	//! Forget measured sizes of the item with the given index.
+	void resetItem( int index );
+	//! Insert item with unknown sizes at the given position.
+	void insertItem( int index, QLayoutItem * item );
 
-TableViewSection::TableViewSection( QWidget * parent )
-	:	QWidget( parent )
-	,	d( new TableViewSectionPrivate( this ) )
+private:
+	//! Header, cells and footer.
+	QList< QLayoutItem* > items;
+	QLayoutItem * header;
+	QLayoutItem * footer;
+	//! Heights of items, -1 if unknown.
+	mutable QVector< int > heights;
+	//! Width heights are measured for.
+	mutable int heightsWidth;
+	//! Size hints of items, invalid if unknown.
+	mutable QVector< QSize > hints;
+	//! Minimum sizes of items, invalid if unknown.
+	mutable QVector< QSize > minimums;
+	//! Last geometries of items.
+	QVector< QRect > geometries;
+	//! Cached sizes.
+	mutable QSize cachedSizeHint;
+	mutable QSize cachedMinimumSize;
+}; // class TableViewSectionLayout
+
+TableViewSectionLayout::TableViewSectionLayout( QWidget * parent )
+	:	QLayout( parent )
+	,	header( 0 )
+	,	footer( 0 )
+	,	heightsWidth( -1 )
 {
-	d->init();
 }
 
-TableViewSection::~TableViewSection()
+TableViewSectionLayout::~TableViewSectionLayout()
 {
+	qDeleteAll( items );
 }
 
-TextLabel *
-TableViewSection::header() const
+void
+TableViewSectionLayout::setHeader( TextLabel * label )
 {
-	return d->header;
-}
+	addChildWidget( label );
 
-TextLabel *
-TableViewSection::footer() const
-{
-	return d->footer;
+	header = new QWidgetItem( label );
+	insertItem( 0, header );
 }
 
 void
-TableViewSection::addCell( TableViewCell * cell )
+TableViewSectionLayout::setFooter( TextLabel * label )
 {
-	insertCell( d->cells.size(), cell );
+	addChildWidget( label );
+
+	footer = new QWidgetItem( label );
+	insertItem( items.size(), footer );
 }
 
 void
-TableViewSection::insertCell( int index, TableViewCell * cell )
+TableViewSectionLayout::insertCell( int index, TableViewCell * cell )
 {
-	if( !cell || index < 0 )
-		return;
-
-	if( index > d->cells.size() )
-		index = d->cells.size();
-
-	int actualIndex = ( index == 0 ? 1 : index + d->cells.size() );
+	addChildWidget( cell );
 
-	if( index != 0 )
-	{
-		RowsSeparator * s = new RowsSeparator( this );
-		d->layout->insertWidget( actualIndex, s );
-		d->separators.insert( index - 1, s );
-		s->show();
-		++actualIndex;
-	}
+	const int pos = qMin( index + ( header ? 1 : 0 ),
+		items.size() - ( footer ? 1 : 0 ) );
 
-	if( cell->parent() != this )
-		cell->setParent( this );
-	d->layout->insertWidget( actualIndex, cell );
-	d->cells.insert( index, cell );
-	cell->setHighlightOnClick( d->highlightCellOnClick );
-	cell->show();
+	insertItem( pos, new QWidgetItem( cell ) );
 }
 
 void
-TableViewSection::removeCell( TableViewCell * cell )
+TableViewSectionLayout::insertItem( int index, QLayoutItem * item )
 {
-	const int index = d->cells.indexOf( cell );
+	items.insert( index, item );
+	heights.insert( index, -1 );
+	hints.insert( index, QSize() );
+	minimums.insert( index, QSize() );
+	geometries.insert( index, QRect() );
 
-	if( index != -1 )
-		removeCell( index );
+	item->widget()->installEventFilter( this );
+
+	itemsChanged();
 }
 
-TableViewCell *
-TableViewSection::removeCell( int index )
+void
+TableViewSectionLayout::removeCell( TableViewCell * cell )
 {
-	if( index >= 0 && index < d->cells.size() )
+	for( int i = 0; i < items.size(); ++i )
 	{
-		TableViewCell * cell = d->cells.at( index );
-
-		if( index != 0 )
+		if( items.at( i )->widget() == cell )
 		{
-			RowsSeparator * s = d->separators.at( index - 1 );
-			d->layout->removeWidget( s );
-			d->separators.removeAt( index - 1 );
-			delete s;
-		}
+			delete takeAt( i );
 
-		d->layout->removeWidget( cell );
-		cell->setParent( 0 );
-		cell->hide();
+			break;
+		}
+	}
+}
 
-		d->cells.removeAt( index );
+QVector< QRect >
+TableViewSectionLayout::separators() const
+{
+	QVector< QRect > result;
 
-		adjustSize();
+	for( int i = 1; i < items.size(); ++i )
+	{
+		if( isCell( i - 1 ) && isCell( i ) && geometries.at( i ).isValid() )
+		{
+			const QRect & g = geometries.at( i );
 
-		return cell;
+			result.append( QRect( g.x(), g.y() - 1, g.width(), 1 ) );
+		}
 	}
-	else
-		return 0;
+
+	return result;
+}
+
+void
+TableViewSectionLayout::addItem( QLayoutItem * item )
+{
+	// Cells are added with insertCell().
+	delete item;
 }
 
 int
-TableViewSection::cellsCount() const
+TableViewSectionLayout::count() const
 {
-	return d->cells.size();
+	return items.size();
 }
 
-TableViewCell *
-TableViewSection::cellAt( int index )
+QLayoutItem *
+TableViewSectionLayout::itemAt( int index ) const
 {
-	if( index >= 0 && index < d->cells.size() )
-		return d->cells.at( index );
+	if( index >= 0 && index < items.size() )
+		return items.at( index );
 	else
 		return 0;
 }
 
+QLayoutItem *
+TableViewSectionLayout::takeAt( int index )
+{
+	if( index < 0 || index >= items.size() )
+		return 0;
+
+	QLayoutItem * item = items.takeAt( index );
+	heights.removeAt( index );
+	hints.removeAt( index );
+	minimums.removeAt( index );
+	geometries.removeAt( index );
+
+	if( item->widget() )
+		item->widget()->removeEventFilter( this );
+
+	if( item == header )
+		header = 0;
+	else if( item == footer )
+		footer = 0;
+
+	itemsChanged();
+
+	return item;
+}
+
 bool
-TableViewSection::highlightCellOnClick() const
+TableViewSectionLayout::isCell( int index ) const
 {
-	return d->highlightCellOnClick;
+	const QLayoutItem * item = items.at( index );
+
+	return ( item != header && item != footer );
 }
 
 void
-TableViewSection::setHighlightCellOnClick( bool on )
+TableViewSectionLayout::updateHeights( int w ) const
 {
-	if( d->highlightCellOnClick != on )
+	if( heightsWidth != w )
 	{
-		d->highlightCellOnClick = on;
-
-		foreach( TableViewCell * cell, d->cells )
-			cell->setHighlightOnClick( on );
+		heights.fill( -1 );
+		heightsWidth = w;
 	}
-}
 
+	for( int i = 0; i < items.size(); ++i )
+	{
+		if( heights.at( i ) < 0 )
+		{
+			const QLayoutItem * item = items.at( i );
 
-//
-// TableViewPrivate
-//
+			if( item->isEmpty() )
+				heights[ i ] = 0;
+			else
+				heights[ i ] = ( item->hasHeightForWidth() ?
+					item->heightForWidth( w ) : item->sizeHint().height() );
+		}
+	}
+}
 
-void
-TableViewPrivate::init()
+int
+TableViewSectionLayout::totalHeight( int w ) const
 {
-	TableView * q = q_func();
-
-	widget = new QWidget( q->viewport() );
-	QSizePolicy sp = QSizePolicy( QSizePolicy::Minimum,
-		QSizePolicy::Minimum );
-	sp.setHeightForWidth( true );
-	widget->setSizePolicy( sp );
-	layout = new QVBoxLayout( widget );
-	layout->setSpacing( 0 );
-	layout->setContentsMargins( 6, 6, 6, 6 );
+	updateHeights( w );
 
-	QSpacerItem * spacer = new QSpacerItem( 0, 0, QSizePolicy::Minimum,
-		QSizePolicy::Expanding );
-	layout->addItem( spacer );
+	int height = 0;
 
-	q->setBackgroundRole( QPalette::Midlight );
-	q->setAutoFillBackground( true );
-	q->setWidgetResizable( true );
-	q->setWidget( widget );
-}
+	for( int i = 0; i < items.size(); ++i )
+	{
+		if( i > 0 && isCell( i - 1 ) && isCell( i ) )
+			height += 1;
 
+		height += heights.at( i );
+	}
 
-//
-// TableView
-//
+	return height;
+}
 
-TableView::TableView( QWidget * parent )
-	:	ScrollArea( new TableViewPrivate( this ), parent )
+void
+TableViewSectionLayout::itemsChanged()
 {
-	TableViewPrivate * d = d_func();
-	d->init();
+	cachedSizeHint = QSize();
+	cachedMinimumSize = QSize();
+
+	// Don't invalidate, heights of other items are still valid.
+	update();
 }
 
-TableView::~TableView()
+void
+TableViewSectionLayout::resetItem( int index )
 {
+	heights[ index ] = -1;
+	hints[ index ] = QSize();
+	minimums[ index ] = QSize();
 }
 
 void
-TableView::addSection( TableViewSection * section )
+TableViewSectionLayout::setGeometry( const QRect & rect )
 {
-	TableViewPrivate * d = d_func();
+	QLayout::setGeometry( rect );
 
-	insertSection( d->sections.size(), section );
+	const QRect r = contentsRect();
+
+	updateHeights( r.width() );
+
+	int y = r.y();
+	int firstChanged = -1;
+
+	for( int i = 0; i < items.size(); ++i )
+	{
+		if( i > 0 && isCell( i - 1 ) && isCell( i ) )
+			y += 1;
+
+		const QRect g( r.x(), y, r.width(), heights.at( i ) );
+
+		if( g != geometries.at( i ) )
+		{
+			if( firstChanged < 0 )
+				firstChanged = y;
+
+			items.at( i )->setGeometry( g );
+			geometries[ i ] = g;
+		}
+
+		y += g.height();
+	}
+
+	// Separators after the first moved item should be repainted.
+	if( firstChanged >= 0 && parentWidget() )
+		parentWidget()->update( QRect( r.x(), firstChanged - 1,
+			r.width(), parentWidget()->height() - firstChanged + 1 ) );
 }
 
 void
-TableView::insertSection( int index, TableViewSection * section )
+TableViewSectionLayout::invalidate()
 {
-	TableViewPrivate * d = d_func();
+	// Called on each activation and updateGeometry() of any item,
+	// so heights of cells are kept, they are reset by eventFilter().
+	for( int i = 0; i < items.size(); ++i )
+	{
+		if( !isCell( i ) )
+			resetItem( i );
+	}
 
-	if( !section || index < 0 )
-		return;
+	cachedSizeHint = QSize();
+	cachedMinimumSize = QSize();
 
-	if( index > d->sections.size() )
-		index = d->sections.size();
+	QLayout::invalidate();
+}
 
-	if( section->parent() != d->widget )
-		section->setParent( d->widget );
-	d->layout->insertWidget( index, section );
-	d->sections.insert( index, section );
-	section->setHighlightCellOnClick( d->highlightCellOnClick );
-	section->show();
+Qt::Orientations
+TableViewSectionLayout::expandingDirections() const
+{
+	return Qt::Horizontal;
 }
 
-void
-TableView::removeSection( TableViewSection * section )
+bool
+TableViewSectionLayout::hasHeightForWidth() const
 {
-	TableViewPrivate * d = d_func();
+	return true;
+}
 
-	const int index = d->sections.indexOf( section );
+int
+TableViewSectionLayout::heightForWidth( int w ) const
+{
+	const QMargins m = contentsMargins();
 
-	if( index != -1 )
-		removeSection( index );
+	return totalHeight( w - m.left() - m.right() ) + m.top() + m.bottom();
 }
 
-TableViewSection *
-TableView::removeSection( int index )
+QSize
+TableViewSectionLayout::size( bool minimum ) const
 {
-	TableViewPrivate * d = d_func();
+	int width = 0;
+	int height = 0;
+	bool prevCell = false;
 
-	if( index >= 0 && index < d->sections.size() )
+	for( int i = 0; i < items.size(); ++i )
 	{
-		TableViewSection * s = d->sections.at( index );
+		const QLayoutItem * item = items.at( i );
 
-		d->layout->removeWidget( s );
-		s->setParent( 0 );
-		s->hide();
+		if( item->isEmpty() )
+			continue;
 
-		d->sections.removeAt( index );
+		QSize & s = ( minimum ? minimums[ i ] : hints[ i ] );
 
-		d->widget->adjustSize();
+		if( !s.isValid() )
+			s = ( minimum ? item->minimumSize() : item->sizeHint() );
 
-		return s;
+		if( prevCell && isCell( i ) )
+			height += 1;
+
+		width = qMax( width, s.width() );
+		height += s.height();
+		prevCell = isCell( i );
 	}
-	else
-		return 0;
+
+	const QMargins m = contentsMargins();
+
+	return QSize( width + m.left() + m.right(), height + m.top() + m.bottom() );
 }
 
-int
-TableView::sectionsCount() const
+QSize
+TableViewSectionLayout::minimumSize() const
 {
-	const TableViewPrivate * d = d_func();
+	if( !cachedMinimumSize.isValid() )
+		cachedMinimumSize = size( true );
 
-	return d->sections.size();
+	return cachedMinimumSize;
 }
 
-TableViewSection *
+QSize
+TableViewSectionLayout::sizeHint() const
+{
+	if( !cachedSizeHint.isValid() )
+		cachedSizeHint = size( false );
+
+	return cachedSizeHint;
+}
+
+bool
+TableViewSectionLayout::eventFilter( QObject * o, QEvent * e )
+{
+	switch( e->type() )
+	{
+		case QEvent::LayoutRequest :
+		case QEvent::ShowToParent :
+		case QEvent::HideToParent :
+		case QEvent::FontChange :
+		case QEvent::StyleChange :
+		case QEvent::ContentsRectChange :
+		{
+			const int index = indexOf( qobject_cast< QWidget* > ( o ) );
+
+			if( index >= 0 )
+				resetItem( index );
+		}
+		break;
+
+		default :
+		break;
+	}
+
+	return QLayout::eventFilter( o, e );
+}
+
+
+//
+// initHeaderLabel
+//
+
+//! Set up label to look like header of the section.
+static void
+initHeaderLabel( TextLabel * header )
+{
+	QSizePolicy sp( QSizePolicy::Minimum, QSizePolicy::Fixed );
+	sp.setHeightForWidth( true );
+
+	header->setBackgroundRole( QPalette::Midlight );
+	header->setAutoFillBackground( true );
+	header->setMargin( 11 );
+	header->setSizePolicy( sp );
+}
+
+
+//
+// initFooterLabel
+//
+
+//! Set up label to look like footer of the section.
+static void
+initFooterLabel( TextLabel * footer )
+{
+	initHeaderLabel( footer );
+
+	QFont font = footer->font();
+	font.setPointSize( qMax( font.pointSize() - 1, 5 ) );
+	footer->setFont( font );
+}
+
+
+//
+// TableViewSectionPrivate
+//
+
+void
+TableViewSectionPrivate::init()
+{
+	q->setSizePolicy( QSizePolicy::Minimum, QSizePolicy::Fixed );
+	q->setBackgroundRole( QPalette::Base );
+	q->setAutoFillBackground( true );
+
+	layout = new TableViewSectionLayout( q );
+	layout->setContentsMargins( 0, 0, 0, 0 );
+
+	header = new TextLabel( q );
+	initHeaderLabel( header );
+	layout->setHeader( header );
+
+	footer = new TextLabel( q );
+	initFooterLabel( footer );
+	layout->setFooter( footer );
+}
+
+void
+TableViewSectionPrivate::beginUpdates()
+{
+	if( updatesDepth++ == 0 )
+		layout->setEnabled( false );
+}
+
+bool
+TableViewSectionPrivate::endUpdates()
+{
+	if( updatesDepth == 0 || --updatesDepth > 0 )
+		return false;
+
+	layout->setEnabled( true );
+
+	return true;
+}
+
+
+//
+// TableViewSection
+//
+
+TableViewSection::TableViewSection( QWidget * parent )
+	:	QWidget( parent )
+	,	d( new TableViewSectionPrivate( this ) )
+{
+	d->init();
+}
+
+TableViewSection::~TableViewSection()
+{
+}
+
+TextLabel *
+TableViewSection::header() const
+{
+	return d->header;
+}
+
+TextLabel *
+TableViewSection::footer() const
+{
+	return d->footer;
+}
+
+void
+TableViewSection::addCell( TableViewCell * cell )
+{
+	insertCell( d->cells.size(), cell );
+}
+
+void
+TableViewSection::insertCell( int index, TableViewCell * cell )
+{
+	if( !cell || index < 0 )
+		return;
+
+	if( index > d->cells.size() )
+		index = d->cells.size();
+
+	if( cell->parent() != this )
+		cell->setParent( this );
+	d->layout->insertCell( index, cell );
+	d->cells.insert( index, cell );
+	cell->setHighlightOnClick( d->highlightCellOnClick );
+	cell->show();
+}
+
+void
+TableViewSection::removeCell( TableViewCell * cell )
+{
+	const int index = d->cells.indexOf( cell );
+
+	if( index != -1 )
+		removeCell( index );
+}
+
+TableViewCell *
+TableViewSection::removeCell( int index )
+{
+	if( index >= 0 && index < d->cells.size() )
+	{
+		TableViewCell * cell = d->cells.at( index );
+
+		d->layout->removeCell( cell );
+		cell->setParent( 0 );
+		cell->hide();
+
+		d->cells.removeAt( index );
+
+		if( d->updatesDepth == 0 )
+			adjustSize();
+
+		return cell;
+	}
+	else
+		return 0;
+}
+
+int
+TableViewSection::cellsCount() const
+{
+	return d->cells.size();
+}
+
+TableViewCell *
+TableViewSection::cellAt( int index )
+{
+	if( index >= 0 && index < d->cells.size() )
+		return d->cells.at( index );
+	else
+		return 0;
+}
+
+bool
+TableViewSection::highlightCellOnClick() const
+{
+	return d->highlightCellOnClick;
+}
+
+void
+TableViewSection::setHighlightCellOnClick( bool on )
+{
+	if( d->highlightCellOnClick != on )
+	{
+		d->highlightCellOnClick = on;
+
+		foreach( TableViewCell * cell, d->cells )
+			cell->setHighlightOnClick( on );
+	}
+}
+
+void
+TableViewSection::addCells( const QList< TableViewCell* > & cells )
+{
+	beginUpdates();
+
+	foreach( TableViewCell * cell, cells )
+		addCell( cell );
+
+	endUpdates();
+}
+
+void
+TableViewSection::beginUpdates()
+{
+	d->beginUpdates();
+}
+
+void
+TableViewSection::endUpdates()
+{
+	if( d->endUpdates() )
+	{
+		d->layout->update();
+		d->layout->activate();
+	}
+}
+
+void
+TableViewSection::paintEvent( QPaintEvent * e )
+{
+	QPainter p( this );
+
+	p.setPen( palette().color( QPalette::Midlight ) );
+
+	foreach( const QRect & r, d->layout->separators() )
+	{
+		if( r.intersects( e->rect() ) )
+			p.drawLine( r.x() + separatorIndent, r.y(), r.x() + r.width(), r.y() );
+	}
+}
+
+
+//
+// TableViewDataSource
+//
+
+TableViewDataSource::~TableViewDataSource()
+{
+}
+
+QString
+TableViewDataSource::headerText( int section ) const
+{
+	Q_UNUSED( section )
+
+	return QString();
+}
+
+QString
+TableViewDataSource::footerText( int section ) const
+{
+	Q_UNUSED( section )
+
+	return QString();
+}
+
+int
+TableViewDataSource::rowHeight( int section, int row ) const
+{
+	Q_UNUSED( section )
+	Q_UNUSED( row )
+
+	return -1;
+}
+
+
+//
+// TableViewCanvas
+//
+
+/*!
+	Widget of the TableView with sections and rows of the data source.
+
+	Sections are laid out as in TableViewSection, but positions and
+	heights of headers, rows and separators are kept in the flat list,
+	and only items intersecting the viewport have widgets. Widgets
+	of items going out of the viewport are returned to pools and
+	reused for items coming in. Separators are painted by the canvas.
+*/
+class TableViewCanvas
+	:	public QWidget
+{
+public:
+	explicit TableViewCanvas( TableViewDataSource * source,
+		QWidget * parent = 0 );
+
+	//! Set data source.
+	void setDataSource( TableViewDataSource * source );
+	//! Enable/disable highlighting of the cell on click.
+	void setHighlightCellOnClick( bool on );
+	//! Forget all items, they will be requested again from the data source.
+	void reload();
+	//! Place widgets for items in the viewport.
+	void layoutVisibleItems();
+	//! \return Cell for the given row if it's visible.
+	TableViewCell * visibleCell( int section, int row ) const;
+	//! \return Section and row of the visible cell.
+	QPair< int, int > indexOfCell( const TableViewCell * cell ) const;
+
+	bool hasHeightForWidth() const override;
+	int heightForWidth( int w ) const override;
+	QSize minimumSizeHint() const override;
+	QSize sizeHint() const override;
+
+protected:
+	void paintEvent( QPaintEvent * e ) override;
+	void resizeEvent( QResizeEvent * e ) override;
+	void moveEvent( QMoveEvent * e ) override;
+
+private:
+	//! Type of the item.
+	enum ItemType {
+		Header,
+		Cell,
+		Separator,
+		Footer
+	}; // enum ItemType
+
+	//! Item of the table.
+	struct Item {
+		ItemType type;
+		int section;
+		int row;
+		int y;
+		int height;
+	}; // struct Item
+
+	//! Item with widget.
+	struct ShownItem {
+		ItemType type;
+		int section;
+		int row;
+		QWidget * widget;
+	}; // struct ShownItem
+
+	//! Lay out items for the given width if needed.
+	void layoutItems( int w ) const;
+	//! \return Height of the item.
+	int itemHeight( ItemType type, int section, int row, int w ) const;
+	//! \return Range of items intersecting the viewport.
+	QPair< int, int > visibleItems() const;
+	//! Take widget for the item from the pool and set it up.
+	QWidget * acquireWidget( const Item & item );
+	//! Return widget of the item to the pool.
+	void releaseWidget( const ShownItem & item );
+	//! Return all widgets to the pools.
+	void releaseAll();
+
+private:
+	Q_DISABLE_COPY( TableViewCanvas )
+
+	//! Data source.
+	TableViewDataSource * source;
+	//! Items of the table.
+	mutable QVector< Item > items;
+	//! Width items were laid out for.
+	mutable int itemsWidth;
+	//! Height of the whole table.
+	mutable int contentHeight;
+	//! Should items be laid out again?
+	mutable bool dirty;
+	//! Incremented each time items are laid out.
+	mutable int generation;
+	//! Generation of the items shown widgets were placed for.
+	int shownGeneration;
+	//! Widgets of the items on the screen by indexes of the items.
+	QHash< int, ShownItem > shown;
+	//! Cells to reuse.
+	QVector< TableViewCell* > cellsPool;
+	//! Headers to reuse.
+	QVector< TextLabel* > headersPool;
+	//! Footers to reuse.
+	QVector< TextLabel* > footersPool;
+	//! Widgets that measure heights of the items.
+	TableViewCell * measureCell;
+	TextLabel * measureHeader;
+	TextLabel * measureFooter;
+	//! Highlight cells on click?
+	bool highlightCellOnClick;
+}; // class TableViewCanvas
+
+//! Margins around the sections, as in the layout of TableView.
+static const int tableViewMargin = 6;
+
+TableViewCanvas::TableViewCanvas( TableViewDataSource * s, QWidget * parent )
+	:	QWidget( parent )
+	,	source( s )
+	,	itemsWidth( -1 )
+	,	contentHeight( 0 )
+	,	dirty( true )
+	,	generation( 0 )
+	,	shownGeneration( 0 )
+	,	measureCell( new TableViewCell( this ) )
+	,	measureHeader( new TextLabel( this ) )
+	,	measureFooter( new TextLabel( this ) )
+	,	highlightCellOnClick( false )
+{
+	QSizePolicy sp = QSizePolicy( QSizePolicy::Minimum,
+		QSizePolicy::Minimum );
+	sp.setHeightForWidth( true );
+	setSizePolicy( sp );
+
+	measureCell->hide();
+	initHeaderLabel( measureHeader );
+	measureHeader->hide();
+	initFooterLabel( measureFooter );
+	measureFooter->hide();
+}
+
+void
+TableViewCanvas::setDataSource( TableViewDataSource * s )
+{
+	source = s;
+
+	reload();
+}
+
+void
+TableViewCanvas::setHighlightCellOnClick( bool on )
+{
+	highlightCellOnClick = on;
+
+	foreach( TableViewCell * cell, cellsPool )
+		cell->setHighlightOnClick( on );
+
+	for( auto it = shown.cbegin(), last = shown.cend(); it != last; ++it )
+	{
+		if( it.value().type == Cell )
+			static_cast< TableViewCell* > ( it.value().widget )->
+				setHighlightOnClick( on );
+	}
+}
+
+void
+TableViewCanvas::reload()
+{
+	releaseAll();
+
+	dirty = true;
+
+	updateGeometry();
+	update();
+}
+
+int
+TableViewCanvas::itemHeight( ItemType type, int section, int row, int w ) const
+{
+	switch( type )
+	{
+		case Header :
+		{
+			measureHeader->setText( source->headerText( section ) );
+
+			return measureHeader->heightForWidth( w );
+		}
+
+		case Footer :
+		{
+			measureFooter->setText( source->footerText( section ) );
+
+			return measureFooter->heightForWidth( w );
+		}
+
+		case Separator :
+			return 1;
+
+		default :
+		{
+			const int h = source->rowHeight( section, row );
+
+			if( h >= 0 )
+				return h;
+
+			source->setupCell( measureCell, section, row );
+
+			return qMax( measureCell->heightForWidth( w ),
+				measureCell->minimumHeight() );
+		}
+	}
+}
+
+void
+TableViewCanvas::layoutItems( int w ) const
+{
+	if( !dirty && itemsWidth == w )
+		return;
+
+	dirty = false;
+	itemsWidth = w;
+	++generation;
+	items.clear();
+
+	int y = tableViewMargin;
+
+	if( source )
+	{
+		const int cw = qMax( 0, w - 2 * tableViewMargin );
+
+		auto add = [&] ( ItemType type, int section, int row )
+		{
+			const int h = itemHeight( type, section, row, cw );
+
+			if( h > 0 )
+			{
+				const Item item = { type, section, row, y, h };
+				items.append( item );
+				y += h;
+			}
+		};
+
+		for( int section = 0, sections = source->sectionsCount();
+			section < sections; ++section )
+		{
+			add( Header, section, -1 );
+
+			for( int row = 0, rows = source->rowsCount( section );
+				row < rows; ++row )
+			{
+				if( row > 0 )
+					add( Separator, section, row );
+
+				add( Cell, section, row );
+			}
+
+			add( Footer, section, -1 );
+		}
+	}
+
+	contentHeight = y + tableViewMargin;
+}
+
+QPair< int, int >
+TableViewCanvas::visibleItems() const
+{
+	const QWidget * viewport = parentWidget();
+
+	const QRect r = ( viewport ? QRect( -pos(), viewport->size() ) : rect() )
+		.intersected( rect() );
+
+	if( r.isEmpty() || items.isEmpty() )
+		return qMakePair( 0, -1 );
+
+	auto first = std::upper_bound( items.cbegin(), items.cend(), r.top(),
+		[] ( int y, const Item & item ) { return y < item.y + item.height; } );
+
+	auto last = std::lower_bound( first, items.cend(), r.bottom() + 1,
+		[] ( const Item & item, int y ) { return item.y < y; } );
+
+	return qMakePair( int( first - items.cbegin() ),
+		int( last - items.cbegin() ) - 1 );
+}
+
+QWidget *
+TableViewCanvas::acquireWidget( const Item & item )
+{
+	switch( item.type )
+	{
+		case Header :
+		{
+			TextLabel * header = 0;
+
+			if( headersPool.isEmpty() )
+			{
+				header = new TextLabel( this );
+				initHeaderLabel( header );
+			}
+			else
+				header = headersPool.takeLast();
+
+			header->setText( source->headerText( item.section ) );
+
+			return header;
+		}
+
+		case Footer :
+		{
+			TextLabel * footer = 0;
+
+			if( footersPool.isEmpty() )
+			{
+				footer = new TextLabel( this );
+				initFooterLabel( footer );
+			}
+			else
+				footer = footersPool.takeLast();
+
+			footer->setText( source->footerText( item.section ) );
+
+			return footer;
+		}
+
+		case Cell :
+		{
+			TableViewCell * cell = 0;
+
+			if( cellsPool.isEmpty() )
+			{
+				cell = new TableViewCell( this );
+				cell->setHighlightOnClick( highlightCellOnClick );
+			}
+			else
+				cell = cellsPool.takeLast();
+
+			source->setupCell( cell, item.section, item.row );
+
+			return cell;
+		}
+
+		default :
+			return 0;
+	}
+}
+
+void
+TableViewCanvas::releaseWidget( const ShownItem & item )
+{
+	item.widget->hide();
+
+	switch( item.type )
+	{
+		case Header :
+			headersPool.append( static_cast< TextLabel* > ( item.widget ) );
+		break;
+
+		case Footer :
+			footersPool.append( static_cast< TextLabel* > ( item.widget ) );
+		break;
+
+		case Cell :
+			cellsPool.append( static_cast< TableViewCell* > ( item.widget ) );
+		break;
+
+		default :
+		break;
+	}
+}
+
+void
+TableViewCanvas::releaseAll()
+{
+	for( auto it = shown.cbegin(), last = shown.cend(); it != last; ++it )
+		releaseWidget( it.value() );
+
+	shown.clear();
+}
+
+void
+TableViewCanvas::layoutVisibleItems()
+{
+	layoutItems( width() );
+
+	// Indexes of shown items are valid only for the same layout.
+	if( shownGeneration != generation )
+	{
+		releaseAll();
+
+		shownGeneration = generation;
+	}
+
+	const QPair< int, int > range = visibleItems();
+
+	for( auto it = shown.begin(); it != shown.end(); )
+	{
+		if( it.key() < range.first || it.key() > range.second )
+		{
+			releaseWidget( it.value() );
+			it = shown.erase( it );
+		}
+		else
+			++it;
+	}
+
+	const int w = qMax( 0, width() - 2 * tableViewMargin );
+
+	for( int i = range.first; i <= range.second; ++i )
+	{
+		const Item & item = items.at( i );
+
+		if( item.type == Separator || shown.contains( i ) )
+			continue;
+
+		QWidget * widget = acquireWidget( item );
+		widget->setGeometry( tableViewMargin, item.y, w, item.height );
+		widget->show();
+		shown.insert( i, { item.type, item.section, item.row, widget } );
+	}
+}
+
+TableViewCell *
+TableViewCanvas::visibleCell( int section, int row ) const
+{
+	for( auto it = shown.cbegin(), last = shown.cend(); it != last; ++it )
+	{
+		const ShownItem & item = it.value();
+
+		if( item.type == Cell && item.section == section && item.row == row )
+			return static_cast< TableViewCell* > ( item.widget );
+	}
+
+	return 0;
+}
+
+QPair< int, int >
+TableViewCanvas::indexOfCell( const TableViewCell * cell ) const
+{
+	for( auto it = shown.cbegin(), last = shown.cend(); it != last; ++it )
+	{
+		const ShownItem & item = it.value();
+
+		if( item.type == Cell && item.widget == cell )
+			return qMakePair( item.section, item.row );
+	}
+
+	return qMakePair( -1, -1 );
+}
+
+bool
+TableViewCanvas::hasHeightForWidth() const
+{
+	return true;
+}
+
+int
+TableViewCanvas::heightForWidth( int w ) const
+{
+	layoutItems( w );
+
+	return contentHeight;
+}
+
+QSize
+TableViewCanvas::minimumSizeHint() const
+{
+	return QSize( 2 * tableViewMargin, 2 * tableViewMargin );
+}
+
+QSize
+TableViewCanvas::sizeHint() const
+{
+	const int w = ( itemsWidth > 0 ? itemsWidth :
+		measureCell->sizeHint().width() + 2 * tableViewMargin );
+
+	return QSize( w, heightForWidth( w ) );
+}
+
+void
+TableViewCanvas::paintEvent( QPaintEvent * )
+{
+	layoutItems( width() );
+
+	const QPair< int, int > range = visibleItems();
+
+	QPainter p( this );
+
+	const QColor base = palette().color( QPalette::Base );
+	const QColor line = palette().color( QPalette::Midlight );
+	const int w = width() - 2 * tableViewMargin;
+
+	for( int i = range.first; i <= range.second; ++i )
+	{
+		const Item & item = items.at( i );
+
+		if( item.type == Separator )
+		{
+			p.fillRect( tableViewMargin, item.y, w, item.height, base );
+			p.setPen( line );
+			p.drawLine( tableViewMargin + separatorIndent, item.y,
+				tableViewMargin + w, item.y );
+		}
+	}
+}
+
+void
+TableViewCanvas::resizeEvent( QResizeEvent * )
+{
+	layoutVisibleItems();
+}
+
+void
+TableViewCanvas::moveEvent( QMoveEvent * )
+{
+	layoutVisibleItems();
+}
+
+
+//
+// TableViewPrivate
+//
+
+void
+TableViewPrivate::init()
+{
+	TableView * q = q_func();
+
+	widget = new QWidget( q->viewport() );
+	QSizePolicy sp = QSizePolicy( QSizePolicy::Minimum,
+		QSizePolicy::Minimum );
+	sp.setHeightForWidth( true );
+	widget->setSizePolicy( sp );
+	layout = new QVBoxLayout( widget );
+	layout->setSpacing( 0 );
+	layout->setContentsMargins( 6, 6, 6, 6 );
+
+	QSpacerItem * spacer = new QSpacerItem( 0, 0, QSizePolicy::Minimum,
+		QSizePolicy::Expanding );
+	layout->addItem( spacer );
+
+	q->setBackgroundRole( QPalette::Midlight );
+	q->setAutoFillBackground( true );
+	q->setWidgetResizable( true );
+	q->setWidget( widget );
+}
+
+
+//
+// TableView
+//
+
+TableView::TableView( QWidget * parent )
+	:	ScrollArea( new TableViewPrivate( this ), parent )
+{
+	TableViewPrivate * d = d_func();
+	d->init();
+}
+
+TableView::~TableView()
+{
+}
+
+void
+TableView::addSection( TableViewSection * section )
+{
+	TableViewPrivate * d = d_func();
+
+	insertSection( d->sections.size(), section );
+}
+
+void
+TableView::insertSection( int index, TableViewSection * section )
+{
+	TableViewPrivate * d = d_func();
+
+	if( !section || index < 0 )
+		return;
+
+	if( index > d->sections.size() )
+		index = d->sections.size();
+
+	if( section->parent() != d->widget )
+		section->setParent( d->widget );
+	d->layout->insertWidget( index, section );
+	d->sections.insert( index, section );
+	section->setHighlightCellOnClick( d->highlightCellOnClick );
+
+	if( d->updatesDepth > 0 )
+		section->d->beginUpdates();
+
+	section->show();
+}
+
+void
+TableView::removeSection( TableViewSection * section )
+{
+	TableViewPrivate * d = d_func();
+
+	const int index = d->sections.indexOf( section );
+
+	if( index != -1 )
+		removeSection( index );
+}
+
+TableViewSection *
+TableView::removeSection( int index )
+{
+	TableViewPrivate * d = d_func();
+
+	if( index >= 0 && index < d->sections.size() )
+	{
+		TableViewSection * s = d->sections.at( index );
+
+		d->layout->removeWidget( s );
+		s->setParent( 0 );
+		s->hide();
+
+		d->sections.removeAt( index );
+
+		if( d->updatesDepth > 0 )
+			s->endUpdates();
+		else
+			d->widget->adjustSize();
+
+		return s;
+	}
+	else
+		return 0;
+}
+
+int
+TableView::sectionsCount() const
+{
+	const TableViewPrivate * d = d_func();
+
+	return d->sections.size();
+}
+
+TableViewSection *
 TableView::sectionAt( int index )
 {
 	TableViewPrivate * d = d_func();
@@ -896,7 +1934,193 @@ TableView::setHighlightCellOnClick( bool on )
 
 		foreach( TableViewSection * sect, d->sections )
 			sect->setHighlightCellOnClick( on );
+
+		if( d->canvas )
+			d->canvas->setHighlightCellOnClick( on );
+	}
+}
+
+TableViewDataSource *
+TableView::dataSource() const
+{
+	const TableViewPrivate * d = d_func();
+
+	return d->dataSource;
+}
+
+void
+TableView::setDataSource( TableViewDataSource * source )
+{
+	TableViewPrivate * d = d_func();
+
+	if( d->dataSource == source )
+		return;
+
+	d->dataSource = source;
+
+	if( source )
+	{
+		if( !d->canvas )
+		{
+			// Keep added sections, they will be shown again without data source.
+			takeWidget();
+			d->widget->setParent( this );
+			d->widget->hide();
+
+			d->canvas = new TableViewCanvas( source );
+			d->canvas->setHighlightCellOnClick( d->highlightCellOnClick );
+			setWidget( d->canvas );
+		}
+		else
+			reloadData();
+	}
+	else
+	{
+		delete takeWidget();
+		d->canvas = 0;
+
+		setWidget( d->widget );
+	}
+}
+
+void
+TableView::reloadData()
+{
+	TableViewPrivate * d = d_func();
+
+	if( !d->canvas )
+		return;
+
+	d->canvas->setDataSource( d->dataSource );
+	d->invalidateSizes();
+	d->updateScrolledSize();
+	d->canvas->layoutVisibleItems();
+}
+
+TableViewCell *
+TableView::visibleCell( int section, int row ) const
+{
+	const TableViewPrivate * d = d_func();
+
+	return ( d->canvas ? d->canvas->visibleCell( section, row ) : 0 );
+}
+
+QPair< int, int >
+TableView::indexOfCell( const TableViewCell * cell ) const
+{
+	const TableViewPrivate * d = d_func();
+
+	return ( d->canvas ? d->canvas->indexOfCell( cell ) : qMakePair( -1, -1 ) );
+}
+
+void
+TableView::addSections( const QList< TableViewSection* > & sections )
+{
+	beginUpdates();
+
+	foreach( TableViewSection * section, sections )
+		addSection( section );
+
+	endUpdates();
+}
+
+void
+TableView::beginUpdates()
+{
+	TableViewPrivate * d = d_func();
+
+	if( d->updatesDepth++ == 0 )
+	{
+		d->layout->setEnabled( false );
+
+		foreach( TableViewSection * section, d->sections )
+			section->d->beginUpdates();
+	}
+}
+
+void
+TableView::endUpdates()
+{
+	TableViewPrivate * d = d_func();
+
+	if( d->updatesDepth == 0 )
+		return;
+
+	if( d->updatesDepth > 1 )
+	{
+		--d->updatesDepth;
+
+		return;
+	}
+
+	// Sections will be laid out when the view resizes them.
+	foreach( TableViewSection * section, d->sections )
+	{
+		if( section->d->endUpdates() )
+			section->d->layout->update();
+	}
+
+	// Resizes of the widget are ignored until the end of the batch,
+	// so heights for width are calculated and scrolled size is set once.
+	d->layout->setEnabled( true );
+	d->layout->update();
+	d->layout->activate();
+
+	if( !d->canvas )
+	{
+		d->invalidateSizes();
+		d->updateScrolledSize();
+	}
+
+	d->updatesDepth = 0;
+}
+
+bool
+TableView::eventFilter( QObject * o, QEvent * e )
+{
+	TableViewPrivate * d = d_func();
+
+	if( d->updatesDepth > 0 && o == widget() && e->type() == QEvent::Resize )
+		return AbstractScrollArea::eventFilter( o, e );
+
+	if( d->canvas && o == d->viewport && e->type() == QEvent::Resize )
+	{
+		const bool res = ScrollArea::eventFilter( o, e );
+
+		// Bigger viewport exposes rows even if the canvas isn't moved or resized.
+		d->canvas->layoutVisibleItems();
+
+		return res;
 	}
+
+	return ScrollArea::eventFilter( o, e );
+}
+
+
+//
+// TableViewBatchUpdate
+//
+
+TableViewBatchUpdate::TableViewBatchUpdate( TableView * v )
+	:	view( v )
+	,	section( 0 )
+{
+	view->beginUpdates();
+}
+
+TableViewBatchUpdate::TableViewBatchUpdate( TableViewSection * s )
+	:	view( 0 )
+	,	section( s )
+{
+	section->beginUpdates();
+}
+
+TableViewBatchUpdate::~TableViewBatchUpdate()
+{
+	if( view )
+		view->endUpdates();
+	else
+		section->endUpdates();
 }
 
 } /* namespace QtMWidgets */
@@ -10,6 +10,7 @@
 // Qt include.
 #include <QWidget>
 #include <QScopedPointer>
+#include <QPair>
 
 // QtMWidgets include.
 #include "scrollarea.hpp"
@@ -173,8 +174,31 @@ public:
 	//! Enable/disable highlighting of the cell on click.
 	void setHighlightCellOnClick( bool on );
 
+	/*!
+		Add new cells to the bottom at once,
+		laying out this section only once.
+
+		\sa addCell()
+	*/
+	void addCells( const QList< TableViewCell* > & cells );
+
+	/*!
+		Start batch update. Until endUpdates() is called cells
+		are added and removed without laying out this section.
+		Calls can be nested.
+
+		\sa TableViewBatchUpdate
+	*/
+	void beginUpdates();
+	//! Finish batch update and lay out this section once.
+	void endUpdates();
+
+protected:
+	void paintEvent( QPaintEvent * e ) override;
+
 private:
 	friend class TableViewSectionPrivate;
+	friend class TableView;
 
 	Q_DISABLE_COPY( TableViewSection )
 
@@ -182,6 +206,45 @@ private:
 }; // class TableViewSection
 
 
+//
+// TableViewDataSource
+//
+
+/*!
+	TableViewDataSource provides sections and rows to the TableView.
+
+	With a data source TableView asks for counts of sections and rows,
+	and creates cells only for rows on the screen. While scrolling cells
+	are reused for other rows, so setupCell() should set up every part
+	of the cell it uses for any row.
+*/
+class TableViewDataSource {
+public:
+	virtual ~TableViewDataSource();
+
+	//! \return Count of sections.
+	virtual int sectionsCount() const = 0;
+	//! \return Count of rows in the \a section.
+	virtual int rowsCount( int section ) const = 0;
+	//! Set up \a cell to show the \a row of the \a section.
+	virtual void setupCell( TableViewCell * cell, int section, int row ) = 0;
+
+	//! \return Text of the header of the \a section. Empty by default.
+	virtual QString headerText( int section ) const;
+	//! \return Text of the footer of the \a section. Empty by default.
+	virtual QString footerText( int section ) const;
+	/*!
+		\return Height of the \a row of the \a section.
+
+		By default returns -1, then the height is measured on the hidden
+		cell set up with setupCell(). It's done for every row, not only
+		for visible ones, each time data are reloaded or width of the view
+		changes. Return fixed heights to not set up each row then.
+	*/
+	virtual int rowHeight( int section, int row ) const;
+}; // class TableViewDataSource
+
+
 //
 // TableView
 //
@@ -257,6 +320,60 @@ public:
 	//! Enable/disable highlighting of the cell on click.
 	void setHighlightCellOnClick( bool on );
 
+	//! \return Data source or 0 if none is set.
+	TableViewDataSource * dataSource() const;
+	/*!
+		Set data source. When data source is set this view shows
+		sections and rows of the data source instead of added sections,
+		that are kept untouched. Set 0 to show added sections again.
+
+		\note Data source won't be deleted by this view.
+	*/
+	void setDataSource( TableViewDataSource * source );
+	/*!
+		Reload sections and rows from the data source.
+		Should be called when data of the data source are changed.
+	*/
+	void reloadData();
+	/*!
+		\return Cell showing the \a row of the \a section, or 0
+		if this row is not on the screen or data source is not set.
+	*/
+	TableViewCell * visibleCell( int section, int row ) const;
+	/*!
+		\return Section and row shown by the \a cell, or ( -1, -1 )
+		if the cell doesn't show a row or data source is not set.
+
+		Cells are reused while scrolling, so the result is valid
+		only until the view is scrolled or laid out again.
+	*/
+	QPair< int, int > indexOfCell( const TableViewCell * cell ) const;
+
+	/*!
+		Add new sections to the bottom at once,
+		laying out this view only once.
+
+		\sa addSection()
+	*/
+	void addSections( const QList< TableViewSection* > & sections );
+
+	/*!
+		Start batch update. Until endUpdates() is called sections
+		and their cells are added and removed without laying out
+		this view and its sections. Calls can be nested.
+
+		\sa TableViewBatchUpdate
+	*/
+	void beginUpdates();
+	/*!
+		Finish batch update. This view and its sections are laid
+		out once, and size of the scrolled area is updated once.
+	*/
+	void endUpdates();
+
+protected:
+	bool eventFilter( QObject * o, QEvent * e ) override;
+
 private:
 	Q_DISABLE_COPY( TableView )
 
@@ -268,6 +385,39 @@ private:
 		{ return reinterpret_cast< const TableViewPrivate* >( d.data() ); }
 }; // class TableView
 
+
+//
+// TableViewBatchUpdate
+//
+
+/*!
+	Batch update of TableView or TableViewSection in the scope.
+
+	\code
+	{
+		QtMWidgets::TableViewBatchUpdate batch( view );
+
+		for( int i = 0; i < 1000; ++i )
+			section->addCell( new QtMWidgets::TableViewCell );
+	}
+	\endcode
+*/
+class TableViewBatchUpdate {
+public:
+	//! Begin batch update of the \a view.
+	explicit TableViewBatchUpdate( TableView * view );
+	//! Begin batch update of the \a section.
+	explicit TableViewBatchUpdate( TableViewSection * section );
+	//! End batch update.
+	~TableViewBatchUpdate();
+
+private:
+	Q_DISABLE_COPY( TableViewBatchUpdate )
+
+	TableView * view;
+	TableViewSection * section;
+}; // class TableViewBatchUpdate
+
 } /* namespace QtMWidgets */
 
 #endif // QTMWIDGETS__TABLEVIEW_HPP__INCLUDED
@@ -6,36 +6,180 @@
 
 // QtMWidgets include.
 #include "textlabel.hpp"
+#include "private/textlabel_p.hpp"
 
 // Qt include.
-#include <QStaticText>
 #include <QPainter>
 #include <QResizeEvent>
 #include <QFontMetrics>
 #include <QTextDocument>
+#include <QThreadPool>
+#include <QPromise>
+#include <QtMath>
+
+// C++ include.
+#include <memory>
+#include <algorithm>
 
 
 namespace QtMWidgets {
 
 //
-// TextLabelPrivate
+// layoutPlainText
 //
 
-class TextLabelPrivate {
-public:
-	TextLabelPrivate( TextLabel * parent )
-		:	q( parent )
-		,	margin( 0 )
+/*!
+	Break plain \a text with line separators into lines.
+	Lines are stored into \a lines if it's not 0.
+	Used in the GUI thread and in the background, so it uses
+	only reentrant classes. In the background \a promise is
+	given, and layout stops when it's canceled.
+
+	\return Size of the text.
+*/
+static QSizeF
+layoutPlainText( const QString & text, const QFont & font,
+	const QTextOption & option, qreal lineWidth, QVector< TextLine > * lines,
+	const QPromise< TextLayout > * promise = 0 )
+{
+	QTextLayout layout( text, font );
+	layout.setTextOption( option );
+
+	qreal height = 0.0;
+	qreal textWidth = 0.0;
+
+	layout.beginLayout();
+
+	forever
 	{
+		if( promise && promise->isCanceled() )
+			break;
+
+		QTextLine line = layout.createLine();
+
+		if( !line.isValid() )
+			break;
+
+		line.setLineWidth( lineWidth );
+
+		if( lines )
+		{
+			const TextLine l = { line.textStart(), line.textLength(), height,
+				line.height(), line.ascent(), line.naturalTextWidth() };
+			lines->append( l );
+		}
+
+		height += line.height();
+		textWidth = qMax( textWidth, line.naturalTextWidth() );
 	}
 
-	void init();
+	layout.endLayout();
+
+	return QSizeF( textWidth, height );
+}
 
-	TextLabel * q;
-	QStaticText staticText;
-	int margin;
-	QColor color;
-}; // class TextLabelPrivate
+
+//
+// layoutParagraphs
+//
+
+//! Maximum length of the block, longer paragraphs are split.
+static const int maxBlockLength = 4096;
+
+/*!
+	Measure heights of paragraphs of plain \a text with new lines
+	into \a layout. Paragraphs longer than maxBlockLength are split
+	into blocks at line breaks, so each drawn block is small. Lines of
+	blocks are not kept, so memory is proportional to the count of
+	blocks. Reentrant, stops when \a promise is canceled.
+*/
+static void
+layoutParagraphs( TextLayout & layout, const QFont & font,
+	const QTextOption & option, const QPromise< TextLayout > * promise = 0 )
+{
+	const QString & text = layout.text;
+
+	layout.paragraphs = true;
+	layout.lines.clear();
+	layout.paragraphStarts.clear();
+	layout.paragraphBottoms.clear();
+
+	qreal height = 0.0;
+	qreal textWidth = 0.0;
+	int start = 0;
+
+	forever
+	{
+		if( promise && promise->isCanceled() )
+			break;
+
+		int end = text.indexOf( QLatin1Char( '\n' ), start );
+
+		if( end < 0 )
+			end = text.size();
+
+		QVector< TextLine > lines;
+
+		const QSizeF size = layoutPlainText( text.mid( start, end - start ),
+			font, option, layout.textWidth,
+			( end - start > maxBlockLength ? &lines : 0 ), promise );
+
+		textWidth = qMax( textWidth, size.width() );
+
+		// Split long paragraph at the first line breaks after each
+		// maxBlockLength characters.
+		int blockStart = 0;
+
+		foreach( const TextLine & line, lines )
+		{
+			if( line.start - blockStart >= maxBlockLength )
+			{
+				layout.paragraphStarts.append( start + blockStart );
+				layout.paragraphBottoms.append( height + line.y );
+
+				blockStart = line.start;
+			}
+		}
+
+		layout.paragraphStarts.append( start + blockStart );
+
+		height += size.height();
+
+		layout.paragraphBottoms.append( height );
+
+		if( end == text.size() )
+			break;
+
+		start = end + 1;
+	}
+
+	layout.size = QSizeF( textWidth, height );
+}
+
+
+//
+// documentMargin
+//
+
+//! \return Margin of QTextDocument, sizes of the text are measured with it.
+static qreal
+documentMargin()
+{
+	static const qreal margin = QTextDocument().documentMargin();
+
+	return margin;
+}
+
+
+//
+// TextLabelPrivate
+//
+
+//! Maximum count of cached heights for widths.
+static const int maxCachedHeights = 16;
+
+//! Maximum count of paragraphs with cached lines.
+static const int maxCachedParagraphs = 64;
 
 void
 TextLabelPrivate::init()
@@ -55,6 +199,347 @@ TextLabelPrivate::init()
 	q->setSizePolicy( sp );
 
 	color = q->palette().color( QPalette::WindowText );
+
+	paragraphLayouts.setMaxCost( maxCachedParagraphs );
+}
+
+bool
+TextLabelPrivate::isPlainText() const
+{
+	switch( staticText.textFormat() )
+	{
+		case Qt::PlainText :
+			return true;
+
+		case Qt::AutoText :
+			return !Qt::mightBeRichText( staticText.text() );
+
+		default :
+			return false;
+	}
+}
+
+QSizeF
+TextLabelPrivate::textSize( qreal width ) const
+{
+	if( !isPlainText() )
+	{
+		QTextDocument doc;
+		doc.setDefaultFont( q->font() );
+		doc.setHtml( staticText.text() );
+		doc.setTextWidth( width );
+		doc.setDefaultTextOption( staticText.textOption() );
+
+		return doc.size();
+	}
+
+	// Lay out lines as QTextDocument does, with its margins around.
+	const QSizeF size = layoutPlainText( plainText(), q->font(),
+		staticText.textOption(),
+		qMax( qreal( 0.0 ), width - 2 * documentMargin() ), 0 );
+
+	return QSizeF( qMax( width, size.width() + 2 * documentMargin() ),
+		size.height() + 2 * documentMargin() );
+}
+
+int
+TextLabelPrivate::layoutHeight( const TextLayout & l ) const
+{
+	return labelHeight( l.size.height() + 2 * documentMargin() );
+}
+
+bool
+TextLabelPrivate::isAsyncLayout() const
+{
+	return asyncLayout && isPlainText();
+}
+
+bool
+TextLabelPrivate::isParagraphLayout() const
+{
+	return virtualizedParagraphs && isPlainText();
+}
+
+QString
+TextLabelPrivate::plainText() const
+{
+	QString text = staticText.text();
+	text.replace( QLatin1Char( '\n' ), QChar::LineSeparator );
+
+	return text;
+}
+
+qreal
+TextLabelPrivate::textWidth( int w ) const
+{
+	const QMargins margins = q->contentsMargins();
+
+	return w - 2 * q->frameWidth() - margins.left() -
+		margins.right() - 2 * margin;
+}
+
+int
+TextLabelPrivate::labelHeight( qreal textHeight ) const
+{
+	const QMargins margins = q->contentsMargins();
+
+	return textHeight + 2 * q->frameWidth() + margins.top() +
+		margins.bottom() + 2 * margin;
+}
+
+void
+TextLabelPrivate::invalidateSizes()
+{
+	heights.clear();
+	minimumSize = QSize();
+
+	// Layout in progress is outdated.
+	++generation;
+	cancelLayout();
+}
+
+void
+TextLabelPrivate::cancelLayout()
+{
+	pendingWidth = -1;
+	pendingProbeWidth = -1;
+
+	if( layoutWatcher )
+		layoutWatcher->future().cancel();
+
+	if( probeWatcher )
+		probeWatcher->future().cancel();
+}
+
+void
+TextLabelPrivate::cacheHeight( int w, int height ) const
+{
+	if( heights.size() >= maxCachedHeights )
+		heights.clear();
+
+	heights.insert( w, height );
+}
+
+void
+TextLabelPrivate::startLayout( int w )
+{
+	if( w == q->width() )
+	{
+		if( pendingWidth == w )
+			return;
+
+		pendingWidth = w;
+
+		runLayout( layoutWatcher, w );
+	}
+	else
+	{
+		if( pendingProbeWidth == w )
+			return;
+
+		pendingProbeWidth = w;
+
+		runLayout( probeWatcher, w );
+	}
+}
+
+void
+TextLabelPrivate::runLayout( QFutureWatcher< TextLayout > * & watcher, int w )
+{
+	if( !watcher )
+	{
+		watcher = new QFutureWatcher< TextLayout >( q );
+
+		QObject::connect( watcher, &QFutureWatcher< TextLayout >::finished,
+			q, &TextLabel::_q_textLaidOut );
+	}
+
+	// Superseded layout is not needed, stop it.
+	watcher->future().cancel();
+
+	auto promise = std::make_shared< QPromise< TextLayout > > ();
+	promise->start();
+
+	watcher->setFuture( promise->future() );
+
+	const TextLayout result = prepareLayout( w );
+	const QFont font = q->font();
+	const QTextOption option = staticText.textOption();
+
+	QThreadPool::globalInstance()->start( [promise, result, font, option] ()
+		{
+			TextLayout r = result;
+
+			if( r.paragraphs )
+				QtMWidgets::layoutParagraphs( r, font, option, promise.get() );
+			else
+				r.size = layoutPlainText( r.text, font, option, r.textWidth,
+					&r.lines, promise.get() );
+
+			// Result of the canceled promise is dropped.
+			promise->addResult( r );
+			promise->finish();
+		} );
+}
+
+TextLayout
+TextLabelPrivate::prepareLayout( int w ) const
+{
+	TextLayout result;
+	result.generation = generation;
+	result.width = w;
+	// Lines are broken as in textSize().
+	result.textWidth = qMax( qreal( 0.0 ),
+		textWidth( w ) - 2 * documentMargin() );
+	result.paragraphs = isParagraphLayout();
+	result.text = ( result.paragraphs ? staticText.text() : plainText() );
+
+	return result;
+}
+
+void
+TextLabelPrivate::setLayout( const TextLayout & l )
+{
+	layout = l;
+
+	paragraphLayouts.clear();
+}
+
+void
+TextLabelPrivate::layoutParagraphs( int w )
+{
+	TextLayout result = prepareLayout( w );
+
+	QtMWidgets::layoutParagraphs( result, q->font(), staticText.textOption() );
+
+	// Keep shown layout if it's still valid for the label.
+	if( layout.generation != generation || layout.width != q->width() ||
+		w == q->width() )
+			setLayout( result );
+
+	cacheHeight( w, layoutHeight( result ) );
+}
+
+const QTextLayout *
+TextLabelPrivate::paragraphLayout( int i ) const
+{
+	if( const QTextLayout * cached = paragraphLayouts.object( i ) )
+		return cached;
+
+	const int start = layout.paragraphStarts.at( i );
+	int end = ( i + 1 < layout.paragraphStarts.size() ?
+		layout.paragraphStarts.at( i + 1 ) : layout.text.size() );
+
+	// Block of the long paragraph doesn't end with new line.
+	if( end > start && layout.text.at( end - 1 ) == QLatin1Char( '\n' ) )
+		--end;
+
+	QTextLayout * paragraph = new QTextLayout( layout.text.mid( start, end - start ),
+		q->font() );
+	paragraph->setTextOption( staticText.textOption() );
+
+	qreal y = 0.0;
+
+	paragraph->beginLayout();
+
+	forever
+	{
+		QTextLine line = paragraph->createLine();
+
+		if( !line.isValid() )
+			break;
+
+		line.setLineWidth( layout.textWidth );
+		line.setPosition( QPointF( 0.0, y ) );
+		y += line.height();
+	}
+
+	paragraph->endLayout();
+
+	paragraphLayouts.insert( i, paragraph );
+
+	return paragraph;
+}
+
+int
+TextLabelPrivate::estimatedHeight( int w ) const
+{
+	// Previous layout is better than nothing.
+	if( layout.generation >= 0 )
+		return layoutHeight( layout );
+
+	const QFontMetrics fm = q->fontMetrics();
+	const QString text = staticText.text();
+	const qreal width = qMax( qreal( 1.0 ), textWidth( w ) );
+	const int lines = text.count( QLatin1Char( '\n' ) ) + 1 +
+		qFloor( text.size() * fm.averageCharWidth() / width );
+
+	return labelHeight( lines * fm.lineSpacing() );
+}
+
+void
+TextLabelPrivate::drawLayout( QPainter * p, const QPoint & topLeft,
+	const QRect & clip ) const
+{
+	const Qt::Alignment hAlign =
+		staticText.textOption().alignment() & Qt::AlignHorizontal_Mask;
+
+	auto it = std::lower_bound( layout.lines.cbegin(), layout.lines.cend(),
+		qreal( clip.top() - topLeft.y() ),
+		[] ( const TextLine & line, qreal y ) { return line.y + line.height < y; } );
+
+	for( auto last = layout.lines.cend();
+		it != last && topLeft.y() + it->y <= clip.bottom(); ++it )
+	{
+		qreal x = 0.0;
+
+		if( hAlign & Qt::AlignRight )
+			x = layout.textWidth - it->width;
+		else if( hAlign & Qt::AlignHCenter )
+			x = ( layout.textWidth - it->width ) / 2.0;
+
+		QString line = layout.text.mid( it->start, it->length );
+
+		while( line.endsWith( QChar::LineSeparator ) )
+			line.chop( 1 );
+
+		p->drawText( QPointF( topLeft.x() + x, topLeft.y() + it->y + it->ascent ),
+			line );
+	}
+}
+
+void
+TextLabelPrivate::drawParagraphs( QPainter * p, const QPoint & topLeft,
+	const QRect & clip ) const
+{
+	const QVector< qreal > & bottoms = layout.paragraphBottoms;
+
+	const int first = std::upper_bound( bottoms.cbegin(), bottoms.cend(),
+		qreal( clip.top() - topLeft.y() ) ) - bottoms.cbegin();
+
+	for( int i = first; i < bottoms.size(); ++i )
+	{
+		const qreal top = ( i > 0 ? bottoms.at( i - 1 ) : 0.0 );
+
+		if( topLeft.y() + top > clip.bottom() )
+			break;
+
+		const QTextLayout * paragraph = paragraphLayout( i );
+		const QPointF pos( topLeft.x(), topLeft.y() + top );
+
+		for( int j = 0; j < paragraph->lineCount(); ++j )
+		{
+			const QTextLine line = paragraph->lineAt( j );
+
+			if( pos.y() + line.y() + line.height() < clip.top() )
+				continue;
+
+			if( pos.y() + line.y() > clip.bottom() )
+				break;
+
+			line.draw( p, pos );
+		}
+	}
 }
 
 
@@ -80,6 +565,7 @@ TextLabel::TextLabel( const QString & text,
 
 TextLabel::~TextLabel()
 {
+	d->cancelLayout();
 }
 
 QString
@@ -93,6 +579,9 @@ TextLabel::setText( const QString & text )
 {
 	d->staticText.setText( text );
 
+	d->invalidateSizes();
+
+	updateGeometry();
 	update();
 }
 
@@ -107,6 +596,9 @@ TextLabel::setTextFormat( Qt::TextFormat format )
 {
 	d->staticText.setTextFormat( format );
 
+	d->invalidateSizes();
+
+	updateGeometry();
 	update();
 }
 
@@ -121,6 +613,9 @@ TextLabel::setTextOption( const QTextOption & textOption )
 {
 	d->staticText.setTextOption( textOption );
 
+	d->invalidateSizes();
+
+	updateGeometry();
 	update();
 }
 
@@ -129,7 +624,11 @@ TextLabel::setFont( const QFont & font )
 {
 	QFrame::setFont( font );
 
-	d->staticText.prepare( QTransform(), font );
+	// In the background mode the text is laid out in the worker thread.
+	if( !d->isAsyncLayout() )
+		d->staticText.prepare( QTransform(), font );
+
+	d->invalidateSizes();
 
 	update();
 }
@@ -153,6 +652,9 @@ TextLabel::setMargin( int margin )
 	d->staticText.setTextWidth( width() - margins.left() -
 		margins.right() - 2 * frameWidth() - 2 * d->margin );
 
+	d->invalidateSizes();
+
+	updateGeometry();
 	update();
 }
 
@@ -185,19 +687,30 @@ TextLabel::heightForWidth( int w ) const
 	if( text().isEmpty() )
 		return 2 * frameWidth();
 
-	const QMargins margins = contentsMargins();
+	const auto it = d->heights.constFind( w );
+
+	if( it != d->heights.cend() )
+		return it.value();
+
+	if( d->isAsyncLayout() )
+	{
+		d->startLayout( w );
+
+		return d->estimatedHeight( w );
+	}
+
+	if( d->isParagraphLayout() )
+	{
+		d->layoutParagraphs( w );
 
-	const qreal width = w - 2 * frameWidth() - margins.left() -
-		margins.right() - 2 * d->margin;
+		return d->heights.value( w );
+	}
+
+	const int height = d->labelHeight( d->textSize( d->textWidth( w ) ).height() );
 
-	QTextDocument doc;
-	doc.setHtml( d->staticText.text() );
-	doc.setTextWidth( width );
-	doc.setDefaultTextOption( d->staticText.textOption() );
+	d->cacheHeight( w, height );
 
-	return doc.size().height() +
-		2 * frameWidth() + margins.top() +
-		margins.bottom() + 2 * d->margin;
+	return height;
 }
 
 QSize
@@ -206,20 +719,33 @@ TextLabel::minimumSizeHint() const
 	if( text().isEmpty() )
 		return QSize( 2 * frameWidth(), 2 * frameWidth() );
 
+	if( d->minimumSize.isValid() )
+		return d->minimumSize;
+
 	const QMargins margins = contentsMargins();
 
-	QTextDocument doc;
-	doc.setHtml( d->staticText.text() );
-	doc.setDefaultTextOption( d->staticText.textOption() );
-	doc.setTextWidth( fontMetrics().averageCharWidth() * 10 );
+	// Don't lay out the whole text, minimum is one line.
+	if( d->isAsyncLayout() || d->isParagraphLayout() )
+	{
+		const QFontMetrics fm = fontMetrics();
+		const int frame = 2 * frameWidth();
+
+		d->minimumSize = QSize( fm.averageCharWidth() * 10 + frame +
+			margins.left() + margins.right() + 2 * d->margin,
+			d->labelHeight( fm.lineSpacing() ) );
 
-	const QSizeF size = doc.size();
+		return d->minimumSize;
+	}
+
+	const QSizeF size = d->textSize( fontMetrics().averageCharWidth() * 10 );
 	const int frame = 2 * frameWidth();
 
-	return QSize( size.width() + frame + margins.left() + margins.right() +
-		2 * d->margin,
+	d->minimumSize = QSize( size.width() + frame + margins.left() +
+		margins.right() + 2 * d->margin,
 		size.height() + frame + margins.top() + margins.bottom() +
 		2 * d->margin );
+
+	return d->minimumSize;
 }
 
 QSize
@@ -239,6 +765,22 @@ TextLabel::paintEvent( QPaintEvent * e )
 	p.setClipRect( cr );
 	p.setPen( d->color );
 
+	const bool async = d->isAsyncLayout();
+	const bool paragraphs = d->isParagraphLayout();
+
+	if( ( async || paragraphs ) && ( d->layout.generation != d->generation ||
+		d->layout.width != width() ) )
+	{
+		// Previous layout is shown until the new one is ready.
+		if( async )
+			d->startLayout( width() );
+		else
+			d->layoutParagraphs( width() );
+	}
+
+	const QSizeF textSize = ( async || paragraphs ?
+		d->layout.size : d->staticText.size() );
+
 	int vAlign = d->staticText.textOption().alignment() & Qt::AlignVertical_Mask;
 
 	QPoint topLeft = cr.topLeft();
@@ -247,14 +789,14 @@ TextLabel::paintEvent( QPaintEvent * e )
 	{
 		case Qt::AlignBottom :
 			topLeft = QPoint( topLeft.x() + d->margin,
-				cr.bottomLeft().y() - qRound( d->staticText.size().height() ) -
+				cr.bottomLeft().y() - qRound( textSize.height() ) -
 				d->margin );
 		break;
 
 		case Qt::AlignVCenter :
 			topLeft = QPoint( topLeft.x() + d->margin,
 				topLeft.y() + cr.height() / 2 -
-					qRound( d->staticText.size().height() ) / 2 );
+					qRound( textSize.height() ) / 2 );
 		break;
 
 		default :
@@ -265,7 +807,12 @@ TextLabel::paintEvent( QPaintEvent * e )
 		break;
 	}
 
-	p.drawStaticText( topLeft, d->staticText );
+	if( d->layout.paragraphs && paragraphs )
+		d->drawParagraphs( &p, topLeft, e->rect() );
+	else if( async && !d->layout.paragraphs )
+		d->drawLayout( &p, topLeft, e->rect() );
+	else if( !async && !paragraphs )
+		p.drawStaticText( topLeft, d->staticText );
 }
 
 void
@@ -279,4 +826,105 @@ TextLabel::resizeEvent( QResizeEvent * e )
 	e->accept();
 }
 
+void
+TextLabel::changeEvent( QEvent * e )
+{
+	switch( e->type() )
+	{
+		case QEvent::FontChange :
+		case QEvent::StyleChange :
+		case QEvent::ContentsRectChange :
+			d->invalidateSizes();
+		break;
+
+		default :
+		break;
+	}
+
+	QFrame::changeEvent( e );
+}
+
+bool
+TextLabel::asyncLayout() const
+{
+	return d->asyncLayout;
+}
+
+void
+TextLabel::setAsyncLayout( bool on )
+{
+	if( d->asyncLayout != on )
+	{
+		d->asyncLayout = on;
+
+		d->setLayout( TextLayout() );
+		d->invalidateSizes();
+
+		updateGeometry();
+		update();
+	}
+}
+
+bool
+TextLabel::virtualizedParagraphs() const
+{
+	return d->virtualizedParagraphs;
+}
+
+void
+TextLabel::setVirtualizedParagraphs( bool on )
+{
+	if( d->virtualizedParagraphs != on )
+	{
+		d->virtualizedParagraphs = on;
+
+		d->setLayout( TextLayout() );
+		d->invalidateSizes();
+
+		updateGeometry();
+		update();
+	}
+}
+
+void
+TextLabel::_q_textLaidOut()
+{
+	QFutureWatcher< TextLayout > * watcher =
+		static_cast< QFutureWatcher< TextLayout >* > ( sender() );
+
+	const QFuture< TextLayout > future = watcher->future();
+
+	if( !future.isFinished() || future.isCanceled() ||
+		future.resultCount() == 0 )
+			return;
+
+	const TextLayout result = future.result();
+
+	if( result.generation != d->generation )
+		return;
+
+	const bool probe = ( watcher == d->probeWatcher );
+
+	if( probe )
+		d->pendingProbeWidth = -1;
+	else
+		d->pendingWidth = -1;
+
+	d->cacheHeight( result.width, d->layoutHeight( result ) );
+
+	// Only layout for the label's width is shown,
+	// for other widths just the height is needed.
+	if( result.width == width() )
+	{
+		d->setLayout( result );
+
+		update();
+	}
+	// Label could be resized while the text was laid out.
+	else if( !probe )
+		d->startLayout( width() );
+
+	updateGeometry();
+}
+
 } /* namespace QtMWidgets */
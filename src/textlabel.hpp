@@ -42,6 +42,10 @@ class TextLabel
 		The default setting is Qt::AutoText; i.e. TextLabel will try to
 		auto-detect the format of the text set.
 
+		Plain and rich text are measured with the label's font. In
+		plain text new lines break lines, in rich text they are
+		white space as usual in HTML.
+
 		\sa setTextFormat()
 	*/
 	Q_PROPERTY( QString text READ text WRITE setText )
@@ -84,6 +88,36 @@ class TextLabel
 		Color of the text.
 	*/
 	Q_PROPERTY( QColor color READ color WRITE setColor )
+	/*!
+		\property asyncLayout
+
+		\brief whether plain text is laid out in the background
+
+		When enabled, plain text is broken into lines in the worker
+		thread after changes of the text, font, options or width,
+		the previous layout is shown until the new one is ready, and
+		geometry is updated when it's ready. Meanwhile heightForWidth()
+		returns estimated height, and minimumSizeHint() is one line high.
+		Rich text is always laid out synchronously.
+
+		By default, this property is false.
+	*/
+	Q_PROPERTY( bool asyncLayout READ asyncLayout WRITE setAsyncLayout )
+	/*!
+		\property virtualizedParagraphs
+
+		\brief whether plain text is laid out and drawn by paragraphs
+
+		When enabled, only heights of paragraphs are kept for the
+		current width, and only paragraphs intersecting the exposed
+		rectangle are laid out and drawn. Use it for very long text
+		in ScrollArea. Together with asyncLayout heights of paragraphs
+		are measured in the background. Rich text is not affected.
+
+		By default, this property is false.
+	*/
+	Q_PROPERTY( bool virtualizedParagraphs READ virtualizedParagraphs
+		WRITE setVirtualizedParagraphs )
 
 public:
 	/*!
@@ -132,6 +166,16 @@ public:
 	//! Set color.
 	void setColor( const QColor & c );
 
+	//! \return Is plain text laid out in the background?
+	bool asyncLayout() const;
+	//! Enable/disable laying out of plain text in the background.
+	void setAsyncLayout( bool on );
+
+	//! \return Is plain text laid out and drawn by paragraphs?
+	bool virtualizedParagraphs() const;
+	//! Enable/disable laying out and drawing of plain text by paragraphs.
+	void setVirtualizedParagraphs( bool on );
+
 	bool hasHeightForWidth() const override;
 	int heightForWidth( int w ) const override;
 	QSize minimumSizeHint() const override;
@@ -140,8 +184,14 @@ public:
 protected:
 	void paintEvent( QPaintEvent * e ) override;
 	void resizeEvent( QResizeEvent * e ) override;
+	void changeEvent( QEvent * e ) override;
+
+private slots:
+	void _q_textLaidOut();
 
 private:
+	friend class TextLabelPrivate;
+
 	Q_DISABLE_COPY( TextLabel )
 
 	QScopedPointer< TextLabelPrivate > d;
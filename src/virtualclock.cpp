@@ -0,0 +1,214 @@
+
+/*
+	SPDX-FileCopyrightText: 2014-2024 Igor Mironchik <igor.mironchik@gmail.com>
+	SPDX-License-Identifier: MIT
+*/
+
+// QtMWidgets include.
+#include "virtualclock.hpp"
+
+// Qt include.
+#include <QElapsedTimer>
+#include <QCoreApplication>
+
+// C++ include.
+#include <limits>
+
+
+namespace QtMWidgets {
+
+static VirtualClock * activeVirtualClock = 0;
+
+static qint64
+systemTime()
+{
+	static const QElapsedTimer timer = [] () {
+		QElapsedTimer t;
+		t.start();
+
+		return t;
+	} ();
+
+	return timer.elapsed();
+}
+
+
+//
+// VirtualClock
+//
+
+VirtualClock::VirtualClock( QObject * parent )
+	:	QAnimationDriver( parent )
+	,	time( 0 )
+	,	startTime( 0 )
+{
+}
+
+VirtualClock::~VirtualClock()
+{
+	deactivate();
+}
+
+void
+VirtualClock::activate()
+{
+	if( activeVirtualClock == this )
+		return;
+
+	if( activeVirtualClock )
+		activeVirtualClock->deactivate();
+
+	// Continue from the current time, so timers that
+	// were started before stay consistent.
+	time = monotonicTime();
+	startTime = time;
+
+	activeVirtualClock = this;
+
+	install();
+}
+
+void
+VirtualClock::deactivate()
+{
+	if( activeVirtualClock != this )
+		return;
+
+	activeVirtualClock = 0;
+
+	uninstall();
+}
+
+bool
+VirtualClock::isActive() const
+{
+	return ( activeVirtualClock == this );
+}
+
+qint64
+VirtualClock::currentTime() const
+{
+	return time;
+}
+
+void
+VirtualClock::setCurrentTime( qint64 msecs )
+{
+	if( msecs > time )
+		time = msecs;
+}
+
+void
+VirtualClock::advanceBy( int msecs )
+{
+	// Animations and timers are registered with queued calls.
+	QCoreApplication::sendPostedEvents();
+
+	setCurrentTime( time + msecs );
+
+	advance();
+}
+
+int
+VirtualClock::advanceWhileRunning( int maxMsecs, int step )
+{
+	if( step <= 0 )
+		return 0;
+
+	QCoreApplication::sendPostedEvents();
+
+	int advanced = 0;
+
+	while( isRunning() && advanced < maxMsecs )
+	{
+		advanceBy( step );
+
+		advanced += step;
+	}
+
+	return advanced;
+}
+
+qint64
+VirtualClock::elapsed() const
+{
+	return ( isRunning() ? time - startTime : 0 );
+}
+
+VirtualClock *
+VirtualClock::active()
+{
+	return activeVirtualClock;
+}
+
+void
+VirtualClock::start()
+{
+	startTime = time;
+
+	QAnimationDriver::start();
+}
+
+
+//
+// monotonicTime
+//
+
+qint64
+monotonicTime()
+{
+	if( activeVirtualClock )
+		return activeVirtualClock->currentTime();
+	else
+		return systemTime();
+}
+
+
+//
+// ElapsedTimer
+//
+
+ElapsedTimer::ElapsedTimer()
+	:	startTime( -1 )
+{
+}
+
+void
+ElapsedTimer::start()
+{
+	startTime = monotonicTime();
+}
+
+qint64
+ElapsedTimer::restart()
+{
+	const qint64 now = monotonicTime();
+	const qint64 result = now - startTime;
+
+	startTime = now;
+
+	return result;
+}
+
+qint64
+ElapsedTimer::elapsed() const
+{
+	if( !isValid() )
+		return std::numeric_limits< qint64 >::max();
+
+	return monotonicTime() - startTime;
+}
+
+void
+ElapsedTimer::invalidate()
+{
+	startTime = -1;
+}
+
+bool
+ElapsedTimer::isValid() const
+{
+	return ( startTime >= 0 );
+}
+
+} /* namespace QtMWidgets */
@@ -0,0 +1,133 @@
+
+/*
+	SPDX-FileCopyrightText: 2014-2024 Igor Mironchik <igor.mironchik@gmail.com>
+	SPDX-License-Identifier: MIT
+*/
+
+#ifndef QTMWIDGETS__VIRTUALCLOCK_HPP__INCLUDED
+#define QTMWIDGETS__VIRTUALCLOCK_HPP__INCLUDED
+
+// Qt include.
+#include <QAbstractAnimation>
+
+
+namespace QtMWidgets {
+
+//
+// VirtualClock
+//
+
+/*!
+	VirtualClock is a time source with manually advanced time.
+
+	All time-dependent behaviour of QtMWidgets goes through the
+	animation driver: animations (kinetic scrolling, blur effects,
+	busy indicators), timers (scroll indicators fading, long touch,
+	autorepeat) and gesture velocity measurement. VirtualClock is
+	a QAnimationDriver, so when it's active nothing happens until
+	the time is advanced, and tests and benchmarks can step through
+	a full fling and its settling without sleeping.
+
+	\code
+	QtMWidgets::VirtualClock clock;
+	clock.activate();
+
+	// Send press, moves and release, calling
+	// clock.setCurrentTime() between them...
+
+	clock.advanceWhileRunning( 5000 );
+	\endcode
+
+	Only one clock can be active at the same time in the thread.
+*/
+class VirtualClock
+	:	public QAnimationDriver
+{
+public:
+	explicit VirtualClock( QObject * parent = 0 );
+	~VirtualClock() override;
+
+	//! Make this clock the time source of animations and timers.
+	void activate();
+	//! Give control back to the system clock.
+	void deactivate();
+	//! \return Is this clock active?
+	bool isActive() const;
+
+	//! \return Current virtual time in milliseconds.
+	qint64 currentTime() const;
+	/*!
+		Set current virtual time without stepping animations.
+		Time can't go back.
+	*/
+	void setCurrentTime( qint64 msecs );
+	//! Move time forward by \a msecs and step animations.
+	void advanceBy( int msecs );
+	/*!
+		Step animations by \a step milliseconds while any of them
+		is running, but not longer than \a maxMsecs.
+
+		\return Time advanced in milliseconds.
+	*/
+	int advanceWhileRunning( int maxMsecs, int step = 16 );
+
+	qint64 elapsed() const override;
+
+	//! \return Active virtual clock or 0.
+	static VirtualClock * active();
+
+protected:
+	void start() override;
+
+private:
+	Q_DISABLE_COPY( VirtualClock )
+
+	//! Current time.
+	qint64 time;
+	//! Time when animations were started.
+	qint64 startTime;
+}; // class VirtualClock
+
+
+//
+// monotonicTime
+//
+
+//! \return Monotonic time in milliseconds, virtual when VirtualClock is active.
+qint64 monotonicTime();
+
+
+//
+// ElapsedTimer
+//
+
+/*!
+	QElapsedTimer-like timer that uses monotonicTime(),
+	so it follows the active VirtualClock.
+*/
+class ElapsedTimer {
+public:
+	ElapsedTimer();
+
+	//! Start timer.
+	void start();
+	//! Restart timer. \return Time elapsed since previous start.
+	qint64 restart();
+	/*!
+		\return Time elapsed since start in milliseconds, or maximum
+		qint64 value if timer is not started.
+	*/
+	qint64 elapsed() const;
+	//! Invalidate timer.
+	void invalidate();
+	//! \return Is timer started?
+	bool isValid() const;
+
+private:
+	//! Start time.
+	qint64 startTime;
+}; // class ElapsedTimer
+
+} /* namespace QtMWidgets */
+
+#endif // QTMWIDGETS__VIRTUALCLOCK_HPP__INCLUDED
@@ -8,9 +8,42 @@
 #include <QObject>
 #include <QtTest/QtTest>
 #include <QSharedPointer>
+#include <QImage>
+#include <QVariantAnimation>
 
 // QtMWidgets include.
 #include <QtMWidgets/BusyIndicator>
+#include <QtMWidgets/private/busyindicator_p.hpp>
+
+
+//
+// isSame
+//
+
+//! \return Do images differ not more than on \a tolerance in each channel?
+static bool
+isSame( const QImage & i1, const QImage & i2, int tolerance )
+{
+	if( i1.size() != i2.size() )
+		return false;
+
+	for( int y = 0; y < i1.height(); ++y )
+	{
+		for( int x = 0; x < i1.width(); ++x )
+		{
+			const QRgb c1 = i1.pixel( x, y );
+			const QRgb c2 = i2.pixel( x, y );
+
+			if( qAbs( qRed( c1 ) - qRed( c2 ) ) > tolerance ||
+				qAbs( qGreen( c1 ) - qGreen( c2 ) ) > tolerance ||
+				qAbs( qBlue( c1 ) - qBlue( c2 ) ) > tolerance ||
+				qAbs( qAlpha( c1 ) - qAlpha( c2 ) ) > tolerance )
+					return false;
+		}
+	}
+
+	return true;
+}
 
 
 class TestBusy
@@ -46,6 +79,80 @@ private slots:
 
 		QVERIFY( i.color() == Qt::red );
 	}
+
+	void testSharedFrames()
+	{
+		QtMWidgets::BusyIndicator i1;
+		i1.setRadius( 20 );
+		i1.setColor( Qt::blue );
+
+		QtMWidgets::BusyIndicator i2;
+		i2.setRadius( 20 );
+		i2.setColor( Qt::blue );
+
+		QtMWidgets::BusyIndicator i3;
+		i3.setRadius( 20 );
+		i3.setColor( Qt::red );
+
+		QVERIFY( i1.isPrerendered() == true );
+
+		i1.grab();
+		i2.grab();
+		i3.grab();
+
+		const QSharedPointer< QtMWidgets::BusyIndicatorFrames > frames =
+			QtMWidgets::BusyIndicatorPrivate::get( &i1 )->frames;
+
+		QVERIFY( !frames.isNull() );
+		QVERIFY( QtMWidgets::BusyIndicatorPrivate::get( &i2 )->frames == frames );
+		QVERIFY( QtMWidgets::BusyIndicatorPrivate::get( &i3 )->frames != frames );
+
+		const qreal dpr = i1.devicePixelRatioF();
+
+		QVERIFY( QtMWidgets::BusyIndicatorFrames::get( 20, 12, Qt::blue,
+			dpr ) == frames );
+		QVERIFY( QtMWidgets::BusyIndicatorFrames::get( 20, 12, Qt::blue,
+			dpr * 2.0 ) != frames );
+		QVERIFY( QtMWidgets::BusyIndicatorFrames::get( 21, 12, Qt::blue,
+			dpr ) != frames );
+
+		i1.setPrerendered( false );
+
+		QVERIFY( i1.isPrerendered() == false );
+		QVERIFY( QtMWidgets::BusyIndicatorPrivate::get( &i1 )->frames.isNull() );
+	}
+
+	void testPrerendered()
+	{
+		QtMWidgets::BusyIndicator i1;
+		i1.setRadius( 20 );
+		i1.setColor( Qt::blue );
+		i1.resize( 50, 50 );
+
+		QtMWidgets::BusyIndicator i2;
+		i2.setRadius( 20 );
+		i2.setColor( Qt::blue );
+		i2.resize( 50, 50 );
+		i2.setPrerendered( false );
+
+		QVariantAnimation * a1 = QtMWidgets::BusyIndicatorPrivate::get( &i1 )->animation;
+		QVariantAnimation * a2 = QtMWidgets::BusyIndicatorPrivate::get( &i2 )->animation;
+
+		a1->stop();
+		a2->stop();
+
+		a1->setCurrentTime( 0 );
+		a2->setCurrentTime( 0 );
+
+		QVERIFY( isSame( i1.grab().toImage(), i2.grab().toImage(), 3 ) );
+
+		a1->setCurrentTime( 500 );
+		a2->setCurrentTime( 500 );
+
+		// Frame is the nearest of sixty frames for the full turn,
+		// i.e. it's rotated on a half of degree more here.
+		QVERIFY( isSame( i1.grab().toImage(), i2.grab().toImage(), 12 ) );
+	}
 };
 
 
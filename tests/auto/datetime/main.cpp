@@ -9,6 +9,7 @@
 #include <QtTest/QtTest>
 #include <QSharedPointer>
 #include <QStyleOption>
+#include <QPaintEvent>
 
 // QtMWidgets include.
 #include <QtMWidgets/DateTimePicker>
@@ -16,6 +17,29 @@
 #include <QtMWidgets/TimePicker>
 
 #include <QtMWidgets/private/datetimeparser.hpp>
+#include <QtMWidgets/private/datetimepicker_p.hpp>
+#include <QtMWidgets/private/localetables.hpp>
+
+
+//
+// PaintRecorder
+//
+
+//! Collects regions of paint events.
+class PaintRecorder
+	:	public QObject
+{
+public:
+	bool eventFilter( QObject * o, QEvent * e ) override
+	{
+		if( e->type() == QEvent::Paint )
+			region += static_cast< QPaintEvent* > ( e )->region();
+
+		return QObject::eventFilter( o, e );
+	}
+
+	QRegion region;
+}; // class PaintRecorder
 
 
 class TestDateTime
@@ -621,6 +645,226 @@ private slots:
 		}
 	}
 
+	void testSectionLabels()
+	{
+		const QDateTime min( { 1900, 1, 1 }, { 0, 0 } );
+		const QDateTime max( { 2100, 12, 31 }, { 23, 59 } );
+		const QDateTime current( { 2020, 2, 24 }, { 13, 5 } );
+
+		QtMWidgets::Section years( QtMWidgets::Section::YearSection );
+
+		QVERIFY( years.fillValues( current, min, max ) );
+		QVERIFY( years.valuesCount == 201 );
+		QVERIFY( years.currentIndex == 120 );
+		QVERIFY( years.label( 0 ) == QStringLiteral( "1900" ) );
+		QVERIFY( years.label( 200 ) == QStringLiteral( "2100" ) );
+		QVERIFY( years.label( 201 ).isEmpty() );
+		QVERIFY( !years.fillValues( current, min, max ) );
+
+		QtMWidgets::Section minutes( QtMWidgets::Section::MinuteSection );
+		minutes.zeroesAdded = true;
+		minutes.fillValues( current, min, max );
+
+		QVERIFY( minutes.valuesCount == 60 );
+		QVERIFY( minutes.currentIndex == 5 );
+		QVERIFY( minutes.label( 5 ) == QStringLiteral( "05" ) );
+
+		QtMWidgets::Section days( QtMWidgets::Section::DaySectionShort );
+		days.fillValues( current, min, max );
+
+		QVERIFY( days.valuesCount == 29 );
+		QVERIFY( days.currentIndex == 23 );
+		QVERIFY( days.label( 23 ) ==
+			QLocale::system().dayName( 1, QLocale::ShortFormat ) +
+				QStringLiteral( " 24" ) );
+
+		QVERIFY( days.fillValues( QDateTime( { 2020, 3, 24 }, { 13, 5 } ),
+			min, max ) );
+		QVERIFY( days.valuesCount == 31 );
+		QVERIFY( days.label( 23 ) ==
+			QLocale::system().dayName( 2, QLocale::ShortFormat ) +
+				QStringLiteral( " 24" ) );
+	}
+
+	void testFormatCache()
+	{
+		const QString format = QStringLiteral( "dd MM yyyy hh mm" );
+
+		QtMWidgets::DateTimeParser p1( QMetaType::QDateTime );
+		QtMWidgets::DateTimeParser p2( QMetaType::QDateTime );
+		QtMWidgets::DateTimeParser p3( QMetaType::QDate );
+
+		QVERIFY( p1.parseFormat( format ) );
+		QVERIFY( p2.parseFormat( format ) );
+		QVERIFY( p3.parseFormat( format ) );
+
+		QVERIFY( p1.sectionsFormat == p2.sectionsFormat );
+		QVERIFY( p1.sectionsFormat != p3.sectionsFormat );
+		QVERIFY( p1.sections.size() == 5 );
+		QVERIFY( p3.sections.size() == 3 );
+		QVERIFY( p1.sections.at( 0 ).type == QtMWidgets::Section::DaySection );
+		QVERIFY( p1.sections.at( 0 ).zeroesAdded );
+
+		QVERIFY( !p1.parseFormat( QStringLiteral( "hh hh" ) ) );
+		QVERIFY( p1.format == format );
+		QVERIFY( p1.sections.size() == 5 );
+
+		// Cache is cleared when it's full, parsers keep their formats.
+		for( int i = 1; i <= 100; ++i )
+			QVERIFY( p2.parseFormat( format + QString( i, QLatin1Char( ' ' ) ) ) );
+
+		QVERIFY( p2.sections.size() == 5 );
+		QVERIFY( p1.sectionsFormat->size() == 5 );
+
+		QtMWidgets::DateTimeParser p4( QMetaType::QDateTime );
+
+		QVERIFY( p4.parseFormat( format ) );
+		QVERIFY( p4.sections.size() == 5 );
+	}
+
+	void testSecondsRepaint()
+	{
+		QtMWidgets::DateTimePicker dt;
+		dt.setFormat( QStringLiteral( "d M yy h m s" ) );
+		dt.setDateTime( { { 2020, 10, 12 }, { 15, 12, 10 } } );
+		dt.show();
+
+		QVERIFY( QTest::qWaitForWindowExposed( &dt ) );
+
+		QTest::qWait( 100 );
+
+		QtMWidgets::DateTimePickerPrivate * d =
+			QtMWidgets::DateTimePickerPrivate::get( &dt );
+
+		QVERIFY( d->sections.size() == 6 );
+
+		const int seconds = d->sections.size() - 1;
+
+		QVERIFY( d->sections.at( seconds ).type ==
+			QtMWidgets::Section::SecondSection );
+
+		// Values of the sections are refilled only by Section::fillValues(),
+		// that always sets count of the values.
+		QVector< int > counts;
+
+		for( int i = 0; i < seconds; ++i )
+		{
+			counts.append( d->sections.at( i ).valuesCount );
+			d->sections[ i ].valuesCount = -1;
+		}
+
+		PaintRecorder recorder;
+		dt.installEventFilter( &recorder );
+
+		dt.setDateTime( { { 2020, 10, 12 }, { 15, 12, 11 } } );
+
+		for( int i = 0; i < seconds; ++i )
+		{
+			QVERIFY( d->sections.at( i ).valuesCount == -1 );
+			d->sections[ i ].valuesCount = counts.at( i );
+		}
+
+		QVERIFY( d->sections.at( seconds ).currentIndex == 11 );
+
+		QTRY_VERIFY( !recorder.region.isEmpty() );
+
+		QTest::qWait( 100 );
+
+		QVERIFY( d->sectionRect( seconds ).contains(
+			recorder.region.boundingRect() ) );
+
+		dt.removeEventFilter( &recorder );
+	}
+
+	void testLocaleTables()
+	{
+		const QSharedPointer< const QtMWidgets::LocaleTables > tables =
+			QtMWidgets::LocaleTables::system();
+		const QLocale locale = QLocale::system();
+
+		QVERIFY( tables == QtMWidgets::LocaleTables::system() );
+		QVERIFY( tables->name() == locale.name() );
+
+		// Locale wasn't changed.
+		QVERIFY( !QtMWidgets::LocaleTables::updateSystem() );
+		QVERIFY( tables == QtMWidgets::LocaleTables::system() );
+
+		for( int i = 1; i <= 7; ++i )
+		{
+			QVERIFY( tables->dayName( i ) == locale.dayName( i ) );
+			QVERIFY( tables->dayName( i, QLocale::ShortFormat ) ==
+				locale.dayName( i, QLocale::ShortFormat ) );
+		}
+
+		for( int i = 1; i <= 12; ++i )
+		{
+			QVERIFY( tables->monthName( i ) == locale.monthName( i ) );
+			QVERIFY( tables->monthName( i, QLocale::ShortFormat ) ==
+				locale.monthName( i, QLocale::ShortFormat ) );
+		}
+
+		QVERIFY( tables->number( 5, false ) == QStringLiteral( "5" ) );
+		QVERIFY( tables->number( 5, true ) == QStringLiteral( "05" ) );
+		QVERIFY( tables->number( 42, true ) == QStringLiteral( "42" ) );
+		QVERIFY( tables->number( 2020, true ) == QStringLiteral( "2020" ) );
+
+		const QFontMetrics fm( m_font );
+		const QLatin1Char space( ' ' );
+
+		const int dayWidth = fm.boundingRect( tables->maxDayName( fm ) +
+			space ).width();
+		const int monthWidth = fm.boundingRect( tables->maxMonthName( fm ) +
+			space ).width();
+
+		for( int i = 1; i <= 7; ++i )
+			QVERIFY( fm.boundingRect( locale.dayName( i ) + space ).width() <=
+				dayWidth );
+
+		for( int i = 1; i <= 12; ++i )
+			QVERIFY( fm.boundingRect( locale.monthName( i ) + space ).width() <=
+				monthWidth );
+
+		// Widths are measured once per font.
+		int measured = 0;
+		const auto measure = [&measured] () { ++measured; return 42; };
+
+		QVERIFY( tables->width( m_font, -1, measure ) == 42 );
+		QVERIFY( tables->width( m_font, -1, measure ) == 42 );
+		QVERIFY( measured == 1 );
+
+		QFont font = m_font;
+		font.setItalic( !m_font.italic() );
+
+		QVERIFY( tables->width( font, -1, measure ) == 42 );
+		QVERIFY( measured == 2 );
+	}
+
+	void testLocaleChange()
+	{
+		QtMWidgets::DateTimePicker dt;
+		dt.setFormat( QStringLiteral( "dd MMMM yyyy" ) );
+
+		QtMWidgets::DateTimePickerPrivate * d =
+			QtMWidgets::DateTimePickerPrivate::get( &dt );
+
+		QVERIFY( d->sections.size() == 3 );
+		QVERIFY( d->sections.at( 1 ).type ==
+			QtMWidgets::Section::MonthSectionLong );
+
+		// Label generated with the previous locale.
+		d->sections[ 1 ].labels.insert( 0, QStringLiteral( "marker" ) );
+
+		QVERIFY( d->sections.at( 1 ).label( 0 ) == QStringLiteral( "marker" ) );
+
+		QEvent e( QEvent::LocaleChange );
+		QApplication::sendEvent( &dt, &e );
+
+		QVERIFY( d->sections.at( 1 ).label( 0 ) ==
+			QtMWidgets::LocaleTables::system()->monthName( 1 ) );
+		QVERIFY( QtMWidgets::LocaleTables::system()->name() ==
+			QLocale::system().name() );
+	}
+
 private:
 	QSharedPointer< QtMWidgets::DateTimePicker > m_dt;
 	QSharedPointer< QtMWidgets::DatePicker > m_d;
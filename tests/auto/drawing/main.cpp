@@ -0,0 +1,193 @@
+
+/*
+	SPDX-FileCopyrightText: 2014-2024 Igor Mironchik <igor.mironchik@gmail.com>
+	SPDX-License-Identifier: MIT
+*/
+
+// Qt include.
+#include <QObject>
+#include <QtTest/QtTest>
+#include <QImage>
+#include <QPainter>
+
+// QtMWidgets include.
+#include <QtMWidgets/private/drawing.hpp>
+
+// C++ include.
+#include <functional>
+
+
+//
+// Primitive
+//
+
+//! Paint primitive.
+typedef std::function< void ( QPainter * p ) > Primitive;
+
+
+//
+// render
+//
+
+//! \return Image with the primitive painted with the given translation.
+static QImage
+render( const Primitive & primitive, const QPointF & offset = QPointF() )
+{
+	QImage image( 60, 40, QImage::Format_ARGB32_Premultiplied );
+	image.fill( Qt::transparent );
+
+	QPainter p( &image );
+	p.setRenderHint( QPainter::Antialiasing );
+	p.translate( offset );
+
+	primitive( &p );
+
+	return image;
+}
+
+
+//
+// isSame
+//
+
+//! \return Do images differ by rounding of blending only?
+static bool
+isSame( const QImage & i1, const QImage & i2 )
+{
+	enum { Tolerance = 2 };
+
+	if( i1.size() != i2.size() )
+		return false;
+
+	for( int y = 0; y < i1.height(); ++y )
+	{
+		for( int x = 0; x < i1.width(); ++x )
+		{
+			const QRgb c1 = i1.pixel( x, y );
+			const QRgb c2 = i2.pixel( x, y );
+
+			if( qAbs( qRed( c1 ) - qRed( c2 ) ) > Tolerance ||
+				qAbs( qGreen( c1 ) - qGreen( c2 ) ) > Tolerance ||
+				qAbs( qBlue( c1 ) - qBlue( c2 ) ) > Tolerance ||
+				qAbs( qAlpha( c1 ) - qAlpha( c2 ) ) > Tolerance )
+					return false;
+		}
+	}
+
+	return true;
+}
+
+
+class TestDrawing
+	:	public QObject
+{
+	Q_OBJECT
+
+private slots:
+
+	void testCylinder()
+	{
+		const QRect r( 10, 5, 30, 30 );
+		const QColor c( Qt::darkGray );
+
+		const QImage cached = render( [&] ( QPainter * p )
+			{ QtMWidgets::drawCylinder( p, r, c, true, false ); } );
+
+		// Cylinder always starts at the top.
+		const QImage direct = render( [&] ( QPainter * p )
+			{ QtMWidgets::paintCylinder( p, QRect( r.x(), 0, r.width(), r.height() ),
+				c, true, false ); } );
+
+		QVERIFY( isSame( cached, direct ) );
+
+		// Now from the cache.
+		QVERIFY( isSame( render( [&] ( QPainter * p )
+			{ QtMWidgets::drawCylinder( p, r, c, true, false ); } ), direct ) );
+	}
+
+	void testSliderHandle()
+	{
+		const QRect r( 10, 5, 30, 20 );
+
+		const QImage cached = render( [&] ( QPainter * p )
+			{ QtMWidgets::drawSliderHandle( p, r, 10, 10,
+				Qt::darkGray, Qt::white ); } );
+
+		const QImage direct = render( [&] ( QPainter * p )
+			{ QtMWidgets::paintSliderHandle( p, r, 10, 10,
+				Qt::darkGray, Qt::white ); } );
+
+		QVERIFY( isSame( cached, direct ) );
+
+		QVERIFY( isSame( render( [&] ( QPainter * p )
+			{ QtMWidgets::drawSliderHandle( p, r, 10, 10,
+				Qt::darkGray, Qt::white ); } ), direct ) );
+	}
+
+	void testArrows()
+	{
+		const QRect r( 10, 7, 15, 21 );
+
+		QVERIFY( isSame(
+			render( [&] ( QPainter * p )
+				{ QtMWidgets::drawArrow( p, r, Qt::blue ); } ),
+			render( [&] ( QPainter * p )
+				{ QtMWidgets::paintArrow( p, r, Qt::blue ); } ) ) );
+
+		QVERIFY( isSame(
+			render( [&] ( QPainter * p )
+				{ QtMWidgets::drawArrow2( p, r, Qt::blue ); } ),
+			render( [&] ( QPainter * p )
+				{ QtMWidgets::paintArrow2( p, r, Qt::blue ); } ) ) );
+	}
+
+	void testIntegerTranslation()
+	{
+		const QRect r( 10, 5, 30, 20 );
+		const QPointF offset( 3.0, 4.0 );
+
+		QVERIFY( isSame(
+			render( [&] ( QPainter * p )
+				{ QtMWidgets::drawSliderHandle( p, r, 10, 10,
+					Qt::darkGray, Qt::white ); }, offset ),
+			render( [&] ( QPainter * p )
+				{ QtMWidgets::paintSliderHandle( p, r, 10, 10,
+					Qt::darkGray, Qt::white ); }, offset ) ) );
+	}
+
+	void testFractionalTranslation()
+	{
+		const QRect r( 10, 5, 30, 20 );
+		const QPointF offset( 0.5, 0.25 );
+
+		// Primitives are painted directly, the cached pixmap would be resampled.
+		QVERIFY( render( [&] ( QPainter * p )
+				{ QtMWidgets::drawCylinder( p, r, Qt::darkGray ); }, offset ) ==
+			render( [&] ( QPainter * p )
+				{ QtMWidgets::paintCylinder( p,
+					QRect( r.x(), 0, r.width(), r.height() ),
+					Qt::darkGray, true, true ); }, offset ) );
+
+		QVERIFY( render( [&] ( QPainter * p )
+				{ QtMWidgets::drawSliderHandle( p, r, 10, 10,
+					Qt::darkGray, Qt::white ); }, offset ) ==
+			render( [&] ( QPainter * p )
+				{ QtMWidgets::paintSliderHandle( p, r, 10, 10,
+					Qt::darkGray, Qt::white ); }, offset ) );
+
+		QVERIFY( render( [&] ( QPainter * p )
+				{ QtMWidgets::drawArrow( p, r, Qt::blue ); }, offset ) ==
+			render( [&] ( QPainter * p )
+				{ QtMWidgets::paintArrow( p, r, Qt::blue ); }, offset ) );
+
+		QVERIFY( render( [&] ( QPainter * p )
+				{ QtMWidgets::drawArrow2( p, r, Qt::blue ); }, offset ) ==
+			render( [&] ( QPainter * p )
+				{ QtMWidgets::paintArrow2( p, r, Qt::blue ); }, offset ) );
+	}
+};
+
+
+QTEST_MAIN( TestDrawing )
+
+#include "main.moc"
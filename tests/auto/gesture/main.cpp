@@ -0,0 +1,128 @@
+
+/*
+	SPDX-FileCopyrightText: 2014-2024 Igor Mironchik <igor.mironchik@gmail.com>
+	SPDX-License-Identifier: MIT
+*/
+
+// Qt include.
+#include <QObject>
+#include <QtTest/QtTest>
+#include <QLabel>
+#include <QBuffer>
+#include <QDataStream>
+
+// QtMWidgets include.
+#include <QtMWidgets/GestureTrace>
+#include <QtMWidgets/PageView>
+
+
+static void
+sendMouseEvent( QWidget * w, QEvent::Type type, const QPoint & pos )
+{
+	QMouseEvent me( type, pos, w->mapToGlobal( pos ),
+		( type == QEvent::MouseMove ? Qt::NoButton : Qt::LeftButton ),
+		( type == QEvent::MouseButtonRelease ? Qt::NoButton : Qt::LeftButton ),
+		{} );
+	QApplication::sendEvent( w, &me );
+}
+
+
+class TestGesture
+	:	public QObject
+{
+	Q_OBJECT
+
+private slots:
+
+	void testRecordAndReplay()
+	{
+		QWidget w;
+		w.resize( 300, 300 );
+
+		QtMWidgets::GestureRecorder recorder( &w );
+
+		QVERIFY( recorder.isRecording() == false );
+
+		recorder.start();
+
+		QVERIFY( recorder.isRecording() == true );
+
+		sendMouseEvent( &w, QEvent::MouseButtonPress, QPoint( 250, 150 ) );
+
+		for( int x = 225; x >= 50; x -= 25 )
+			sendMouseEvent( &w, QEvent::MouseMove, QPoint( x, 150 ) );
+
+		sendMouseEvent( &w, QEvent::MouseButtonRelease, QPoint( 50, 150 ) );
+
+		recorder.stop();
+
+		QVERIFY( recorder.isRecording() == false );
+
+		QtMWidgets::GestureTrace trace = recorder.trace();
+
+		QVERIFY( trace.size() == 10 );
+		QVERIFY( trace.first().type == QEvent::MouseButtonPress );
+		QVERIFY( trace.first().pos == QPoint( 250, 150 ) );
+		QVERIFY( trace.at( 1 ).type == QEvent::MouseMove );
+		QVERIFY( trace.last().type == QEvent::MouseButtonRelease );
+		QVERIFY( trace.last().pos == QPoint( 50, 150 ) );
+
+		for( int i = 0; i < trace.size(); ++i )
+			trace[ i ].time = i * 10;
+
+		{
+			QBuffer buffer;
+			buffer.open( QIODevice::ReadWrite );
+
+			QDataStream out( &buffer );
+			out << trace;
+
+			buffer.seek( 0 );
+
+			QtMWidgets::GestureTrace loaded;
+
+			QDataStream in( &buffer );
+			in >> loaded;
+
+			QVERIFY( loaded.size() == trace.size() );
+			QVERIFY( loaded.last().type == trace.last().type );
+			QVERIFY( loaded.last().pos == trace.last().pos );
+			QVERIFY( loaded.last().time == trace.last().time );
+		}
+
+		QtMWidgets::PageView p;
+		p.resize( 300, 300 );
+		p.show();
+
+		QVERIFY( QTest::qWaitForWindowExposed( &p ) );
+
+		QLabel w1( QStringLiteral( "1" ) );
+		p.addWidget( &w1 );
+
+		QLabel w2( QStringLiteral( "2" ) );
+		p.addWidget( &w2 );
+
+		QVERIFY( p.currentIndex() == 0 );
+
+		QtMWidgets::GestureReplayer replayer( &p );
+
+		QVERIFY( replayer.frameInterval() == 16 );
+		QVERIFY( replayer.maximumSettleTime() == 5000 );
+
+		const QtMWidgets::GestureReplayResult result = replayer.replay( trace );
+
+		// Page normalization animation takes 300 ms.
+		QVERIFY( result.frames >= 300 / replayer.frameInterval() );
+		QVERIFY( result.frames < 5000 / replayer.frameInterval() );
+		QVERIFY( result.paintTimes.size() == result.frames );
+		QVERIFY( result.droppedFrames <= result.frames );
+		QVERIFY( result.maximumPaintTime() >= result.averagePaintTime() );
+
+		QVERIFY( p.currentIndex() == 1 );
+	}
+};
+
+
+QTEST_MAIN( TestGesture )
+
+#include "main.moc"
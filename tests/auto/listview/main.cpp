@@ -12,6 +12,7 @@
 // QtMWidgets include.
 #include <QtMWidgets/AbstractListView>
 #include <QtMWidgets/AbstractListModel>
+#include <QtMWidgets/VirtualClock>
 
 
 class ListView
@@ -273,6 +274,89 @@ private slots:
 		}
 	}
 
+	void testVirtualClock()
+	{
+		ListView w;
+
+		for( int i = 0; i < 100; ++i )
+			w.model()->appendRow( m_data.at( i % m_data.size() ) );
+
+		w.resize( 100, 200 );
+		w.show();
+
+		QVERIFY( QTest::qWaitForWindowExposed( &w ) );
+
+		QtMWidgets::VirtualClock clock;
+		clock.activate();
+
+		QVERIFY( clock.isActive() );
+		QVERIFY( QtMWidgets::VirtualClock::active() == &clock );
+
+		const QPoint c = w.rect().center();
+
+		{
+			QSignalSpy spy( &w, &QtMWidgets::AbstractListViewBase::rowLongTouched );
+
+			QMouseEvent press( QEvent::MouseButtonPress, c, w.mapToGlobal( c ),
+				Qt::LeftButton, Qt::LeftButton, {} );
+			QApplication::sendEvent( &w, &press );
+
+			clock.advanceBy( 1000 );
+
+			QVERIFY( spy.count() == 0 );
+
+			clock.advanceBy( 1100 );
+
+			QVERIFY( spy.count() == 1 );
+
+			QMouseEvent release( QEvent::MouseButtonRelease, c, w.mapToGlobal( c ),
+				Qt::LeftButton, Qt::NoButton, {} );
+			QApplication::sendEvent( &w, &release );
+
+			clock.advanceWhileRunning( 1000 );
+		}
+
+		{
+			QPoint pos( c.x(), w.height() - 10 );
+
+			QMouseEvent press( QEvent::MouseButtonPress, pos, w.mapToGlobal( pos ),
+				Qt::LeftButton, Qt::LeftButton, {} );
+			QApplication::sendEvent( &w, &press );
+
+			for( int i = 0; i < 4; ++i )
+			{
+				clock.setCurrentTime( clock.currentTime() + 10 );
+
+				pos -= QPoint( 0, 30 );
+
+				QMouseEvent move( QEvent::MouseMove, pos, w.mapToGlobal( pos ),
+					Qt::NoButton, Qt::LeftButton, {} );
+				QApplication::sendEvent( &w, &move );
+			}
+
+			clock.setCurrentTime( clock.currentTime() + 10 );
+
+			QMouseEvent release( QEvent::MouseButtonRelease, pos,
+				w.mapToGlobal( pos ), Qt::LeftButton, Qt::NoButton, {} );
+			QApplication::sendEvent( &w, &release );
+
+			const int afterDrag = w.topLeftPointShownArea().y();
+
+			QVERIFY( afterDrag > 0 );
+
+			const int settled = clock.advanceWhileRunning( 10000 );
+
+			QVERIFY( settled > 0 );
+			QVERIFY( settled < 10000 );
+			QVERIFY( w.topLeftPointShownArea().y() > afterDrag );
+		}
+
+		clock.deactivate();
+
+		QVERIFY( !clock.isActive() );
+		QVERIFY( QtMWidgets::VirtualClock::active() == nullptr );
+	}
+
 private:
 	QSharedPointer< ListView > m_w;
 	QVector< QColor > m_data;
@@ -10,9 +10,78 @@
 #include <QSharedPointer>
 #include <QStringListModel>
 #include <QtGlobal>
+#include <QFontMetrics>
+#include <QPainter>
+#include <QImage>
 
 // QtMWidgets include.
 #include <QtMWidgets/Picker>
+#include <QtMWidgets/private/utils.hpp>
+#include <QtMWidgets/private/itemstrip.hpp>
+#include <QtMWidgets/private/picker_p.hpp>
+
+
+//
+// linearElide
+//
+
+//! Elision measuring the string after every character, as it was before.
+static QString
+linearElide( const QString & text, const QRect & r, int flags,
+	const QFontMetrics & fm )
+{
+	const QRect & b = fm.boundingRect( r, flags, text );
+
+	QString res = text;
+
+	if( b.width() > r.width() )
+	{
+		int w = 0;
+		int x = 0;
+
+		res.clear();
+
+		while( w <= ( r.width() ) / 2 )
+		{
+			res.append( text.at( x ) );
+			++x;
+			w = fm.boundingRect( r, flags, res ).width();
+		}
+
+		res.append( QStringLiteral( "..." ) );
+
+		x = text.length() - 1;
+		QString tmp = text.at( x );
+
+		while( fm.boundingRect( r, flags, res + tmp ).width() <= r.width() )
+		{
+			--x;
+			tmp.prepend( text.at( x ) );
+		}
+
+		res.append( text.right( text.length() - x - 1 ) );
+	}
+
+	return res;
+}
+
+
+//
+// longTexts
+//
+
+//! \return Texts with 500 characters.
+static QStringList
+longTexts()
+{
+	QStringList texts;
+
+	for( int i = 0; i < 10; ++i )
+		texts.append( QString( 500, QLatin1Char( char( 'a' + i ) ) ) );
+
+	return texts;
+}
+
 
 class StringListEvenDisabledModel
 	:	public QStringListModel
@@ -33,6 +102,58 @@ protected:
 	}
 };
 
+class LazyModel
+	:	public QAbstractListModel
+{
+public:
+	explicit LazyModel( QObject * parent = nullptr )
+		:	QAbstractListModel( parent )
+		,	m_loaded( 0 )
+	{
+	}
+
+	int rowCount( const QModelIndex & parent = QModelIndex() ) const override
+	{
+		return ( parent.isValid() ? 0 : m_loaded );
+	}
+
+	QVariant data( const QModelIndex & index, int role ) const override
+	{
+		if( !index.isValid() || index.row() >= m_loaded )
+			return QVariant();
+
+		if( role == Qt::DisplayRole )
+			return QString::number( index.row() );
+
+		return QVariant();
+	}
+
+	bool canFetchMore( const QModelIndex & parent ) const override
+	{
+		return ( !parent.isValid() && m_loaded < c_total );
+	}
+
+	void fetchMore( const QModelIndex & parent ) override
+	{
+		if( parent.isValid() )
+			return;
+
+		const int count = qMin( int( c_batch ), c_total - m_loaded );
+
+		beginInsertRows( QModelIndex(), m_loaded, m_loaded + count - 1 );
+		m_loaded += count;
+		endInsertRows();
+	}
+
+	enum {
+		c_total = 1000,
+		c_batch = 20
+	};
+
+private:
+	int m_loaded;
+};
+
 
 class TestPicker
 	:	public QObject
@@ -208,6 +329,364 @@ private slots:
 		m_picker->setModel( &m_model );
 	}
 
+	void testRowsRemapping()
+	{
+		QStringListModel model( m_data );
+
+		QtMWidgets::Picker picker;
+		picker.setModel( &model );
+		picker.setCurrentIndex( 3 );
+
+		QSignalSpy spy( &picker, QOverload< int >::of(
+			&QtMWidgets::Picker::currentIndexChanged ) );
+
+		model.insertRows( 0, 2 );
+
+		QVERIFY( spy.count() == 1 );
+		QVERIFY( picker.currentIndex() == 5 );
+		QVERIFY( picker.currentText() == m_data.at( 3 ) );
+
+		model.removeRows( 0, 2 );
+
+		QVERIFY( spy.count() == 2 );
+		QVERIFY( picker.currentIndex() == 3 );
+		QVERIFY( picker.currentText() == m_data.at( 3 ) );
+
+		model.moveRows( QModelIndex(), 3, 1, QModelIndex(), 0 );
+
+		QVERIFY( picker.currentIndex() == 0 );
+		QVERIFY( picker.currentText() == m_data.at( 3 ) );
+
+		model.sort( 0 );
+
+		QVERIFY( picker.currentText() == m_data.at( 3 ) );
+		QVERIFY( picker.currentIndex() ==
+			model.stringList().indexOf( m_data.at( 3 ) ) );
+	}
+
+	void testSizeHint()
+	{
+		const QString longText =
+			QStringLiteral( "Very very very very very very very long line" );
+
+		QtMWidgets::Picker picker;
+		picker.addItems( m_data );
+
+		const int width = picker.sizeHint().width();
+
+		picker.addItem( longText );
+
+		QVERIFY( picker.sizeHint().width() > width );
+
+		picker.removeItem( picker.count() - 1 );
+
+		QVERIFY( picker.sizeHint().width() == width );
+
+		picker.setItemText( 0, longText );
+
+		QVERIFY( picker.sizeHint().width() > width );
+
+		picker.setItemText( 0, m_data.at( 0 ) );
+
+		QVERIFY( picker.sizeHint().width() == width );
+
+		QVERIFY( picker.measuredItemsLimit() == 0 );
+
+		picker.setMeasuredItemsLimit( 4 );
+
+		QVERIFY( picker.measuredItemsLimit() == 4 );
+		QVERIFY( picker.sizeHint().width() <= width );
+	}
+
+	void testGenerator()
+	{
+		QtMWidgets::Picker picker;
+
+		QSignalSpy spy( &picker, QOverload< int >::of(
+			&QtMWidgets::Picker::currentIndexChanged ) );
+
+		picker.setRange( 0, 1000000, 1, QStringLiteral( "%1 m" ) );
+
+		QVERIFY( picker.hasGenerator() );
+		QVERIFY( picker.count() == 1000001 );
+		QVERIFY( picker.currentIndex() == 0 );
+		QVERIFY( spy.count() == 1 );
+		QVERIFY( picker.itemText( 1000000 ) == QStringLiteral( "1000000 m" ) );
+		QVERIFY( picker.itemData( 500 ).toInt() == 500 );
+		QVERIFY( picker.findData( 777777 ) == 777777 );
+		QVERIFY( picker.findText( QStringLiteral( "42 m" ) ) == 42 );
+
+		picker.setCurrentIndex( 123456 );
+
+		QVERIFY( picker.currentText() == QStringLiteral( "123456 m" ) );
+		QVERIFY( picker.currentData().toInt() == 123456 );
+		QVERIFY( picker.sizeHint().width() > 0 );
+		QVERIFY( !picker.grab().isNull() );
+
+		QTest::ignoreMessage( QtWarningMsg,
+			"QtMWidgets::Picker::insertItem: items are generated" );
+		picker.addItem( QStringLiteral( "Wrong" ) );
+
+		QVERIFY( picker.count() == 1000001 );
+
+		picker.setRange( -10, 10, 5 );
+
+		QVERIFY( picker.count() == 5 );
+		QVERIFY( picker.itemText( 0 ) == QStringLiteral( "-10" ) );
+		QVERIFY( picker.findData( 5 ) == 3 );
+		QVERIFY( picker.findData( 3 ) == -1 );
+
+		picker.setGenerator( 3, [] ( int index )
+			{ return QString( index + 1, QLatin1Char( 'a' ) ); } );
+
+		QVERIFY( picker.count() == 3 );
+		QVERIFY( picker.itemText( 2 ) == QStringLiteral( "aaa" ) );
+		QVERIFY( !picker.itemData( 0 ).isValid() );
+		QVERIFY( picker.findText( QStringLiteral( "AA" ), Qt::MatchFixedString ) == 1 );
+
+		QVERIFY( picker.wrapping() );
+
+		picker.setWrapping( false );
+
+		QVERIFY( !picker.wrapping() );
+
+		picker.clear();
+
+		QVERIFY( !picker.hasGenerator() );
+		QVERIFY( picker.count() == 0 );
+		QVERIFY( picker.currentIndex() == -1 );
+
+		picker.addItem( m_data.at( 0 ) );
+
+		QVERIFY( picker.count() == 1 );
+		QVERIFY( picker.currentIndex() == 0 );
+	}
+
+	void testNoWrappingRender()
+	{
+		QStringList texts;
+
+		for( int i = 0; i < 20; ++i )
+			texts.append( QString::number( i ) );
+
+		QStringList otherTexts = texts;
+
+		for( int i = 0; i < 5; ++i )
+			otherTexts[ i ] = QStringLiteral( "WWWW" );
+
+		QtMWidgets::Picker p1;
+		p1.addItems( texts );
+
+		QtMWidgets::Picker p2;
+		p2.addItems( otherTexts );
+
+		foreach( QtMWidgets::Picker * p, QList< QtMWidgets::Picker* > () << &p1 << &p2 )
+		{
+			p->setWrapping( false );
+			p->setCurrentIndex( 19 );
+			// Leave space below the last row.
+			p->resize( p1.sizeHint().width(), p1.sizeHint().height() * 2 );
+		}
+
+		// First rows would be drawn after the last one if rows wrapped.
+		QVERIFY( p1.grab().toImage() == p2.grab().toImage() );
+	}
+
+	void testLazyModel()
+	{
+		LazyModel model;
+
+		QtMWidgets::Picker picker;
+		picker.setModel( &model );
+
+		QVERIFY( picker.count() == 0 );
+		QVERIFY( picker.currentIndex() == -1 );
+
+		QVERIFY( !picker.grab().isNull() );
+
+		QTRY_VERIFY( picker.count() == LazyModel::c_batch );
+		QVERIFY( picker.currentIndex() == 0 );
+		QVERIFY( picker.currentText() == QStringLiteral( "0" ) );
+
+		picker.setCurrentIndex( picker.count() - 1 );
+		picker.grab();
+
+		QTRY_VERIFY( picker.count() == LazyModel::c_batch * 2 );
+		QVERIFY( picker.currentIndex() == LazyModel::c_batch - 1 );
+
+		QTest::qWait( 50 );
+
+		QVERIFY( picker.count() < LazyModel::c_total );
+	}
+
+	void testTextIndex()
+	{
+		QStringListModel model( m_data );
+
+		QtMWidgets::Picker picker;
+		picker.setModel( &model );
+
+		QVERIFY( !picker.isTextIndexEnabled() );
+
+		picker.setTextIndexEnabled( true );
+
+		QVERIFY( picker.isTextIndexEnabled() );
+		QVERIFY( picker.findText( m_data.at( 6 ) ) == 6 );
+		QVERIFY( picker.findText( QStringLiteral( "polish" ) ) == -1 );
+		QVERIFY( picker.findText( QStringLiteral( "polish" ),
+			Qt::MatchFixedString ) == 6 );
+		QVERIFY( picker.findText( QStringLiteral( "po" ),
+			Qt::MatchStartsWith ) == 4 );
+		QVERIFY( picker.findText( QStringLiteral( "po" ),
+			static_cast< Qt::MatchFlags > ( Qt::MatchStartsWith |
+				Qt::MatchCaseSensitive ) ) == -1 );
+
+		model.insertRows( 0, 1 );
+		model.setData( model.index( 0, 0 ), QStringLiteral( "Polish" ) );
+
+		QVERIFY( picker.findText( m_data.at( 6 ) ) == 0 );
+		QVERIFY( picker.findText( m_data.at( 4 ) ) == 5 );
+
+		model.removeRows( 0, 2 );
+
+		QVERIFY( picker.findText( m_data.at( 6 ) ) == 5 );
+		QVERIFY( picker.findText( m_data.at( 0 ) ) == -1 );
+
+		QTest::keyClicks( &picker, QStringLiteral( "po" ) );
+
+		QVERIFY( picker.currentIndex() == 3 );
+
+		QTest::keyClicks( &picker, QStringLiteral( "l" ) );
+
+		QVERIFY( picker.currentIndex() == 5 );
+
+		QStringList texts;
+
+		for( int i = 0; i < 5000; ++i )
+			texts.append( QString::number( 4999 - i ) );
+
+		model.setStringList( texts );
+
+		QVERIFY( picker.findText( QStringLiteral( "4000" ) ) == 999 );
+
+		QTRY_VERIFY( QtMWidgets::PickerPrivate::get( &picker )->textIndexValid );
+
+		QVERIFY( picker.findText( QStringLiteral( "4000" ) ) == 999 );
+		QVERIFY( picker.findText( QStringLiteral( "1234" ) ) == 3765 );
+	}
+
+	void testItemStrip()
+	{
+		enum { Width = 40, RowHeight = 10, Rows = 7 };
+
+		QtMWidgets::ItemStrip strip;
+		QVector< int > drawn;
+
+		const QtMWidgets::ItemStrip::DrawRow drawRow =
+			[&] ( QPainter * p, int row, int y )
+			{
+				drawn.append( row );
+				p->fillRect( 0, y, Width, RowHeight, QColor( row * 30, 0, 0 ) );
+			};
+
+		QVERIFY( strip.rowPosition( 0, 3, Rows ) == -1 );
+
+		strip.setGeometry( Width, RowHeight, 1.0 );
+		strip.render( 5, 5, Rows, QFont(), drawRow );
+
+		// Rows wrap around.
+		QVERIFY( drawn == QVector< int >( { 5, 6, 0, 1, 2 } ) );
+		QVERIFY( strip.rowPosition( 5, 3, Rows ) == 0 );
+		QVERIFY( strip.rowPosition( 0, 3, Rows ) == 2 );
+		QVERIFY( strip.rowPosition( 1, 3, Rows ) == -1 );
+		QVERIFY( strip.rowPosition( 3, 1, Rows ) == -1 );
+		QVERIFY( strip.rowPosition( 5, 3, Rows + 1 ) == -1 );
+
+		QImage image( Width, RowHeight * 3, QImage::Format_ARGB32_Premultiplied );
+		image.fill( Qt::transparent );
+
+		{
+			QPainter p( &image );
+			strip.draw( &p, 0, 0, strip.rowPosition( 6, 3, Rows ) );
+		}
+
+		QVERIFY( image.pixelColor( 0, 0 ) == QColor( 180, 0, 0 ) );
+		QVERIFY( image.pixelColor( Width - 1, RowHeight ) == QColor( 0, 0, 0 ) );
+		QVERIFY( image.pixelColor( 0, RowHeight * 3 - 1 ) == QColor( 30, 0, 0 ) );
+
+		// The same geometry keeps the strip.
+		strip.setGeometry( Width, RowHeight, 1.0 );
+
+		QVERIFY( strip.rowPosition( 5, 3, Rows ) == 0 );
+
+		strip.setGeometry( Width, RowHeight + 1, 1.0 );
+
+		QVERIFY( strip.rowPosition( 5, 3, Rows ) == -1 );
+
+		strip.render( 0, 3, Rows, QFont(), drawRow );
+
+		QVERIFY( strip.rowPosition( 0, 3, Rows ) == 0 );
+
+		strip.invalidate();
+
+		QVERIFY( strip.rowPosition( 0, 3, Rows ) == -1 );
+	}
+
+	void testElideForDevice()
+	{
+		const QFont font;
+		const QString text = QStringLiteral( "Some text to fit" );
+		const int flags = Qt::AlignLeft | Qt::AlignVCenter;
+		const QRect r( 0, 0, QFontMetrics( font ).horizontalAdvance( text ) + 2, 20 );
+
+		QVERIFY( QtMWidgets::accomodateString( text, r, flags, font ) == text );
+
+		// Text is wider on the device with higher DPI (480).
+		QImage image( 10, 10, QImage::Format_ARGB32_Premultiplied );
+		image.setDotsPerMeterX( 18898 );
+		image.setDotsPerMeterY( 18898 );
+
+		QVERIFY( QtMWidgets::accomodateString( text, r, flags, font, &image )
+			.contains( QLatin1String( "..." ) ) );
+	}
+
+	void benchmarkElideString()
+	{
+		const QStringList texts = longTexts();
+		const QFont font;
+		const int flags = Qt::AlignLeft | Qt::AlignVCenter;
+		int i = 0;
+
+		QVERIFY( QtMWidgets::accomodateString( texts.first(),
+			QRect( 0, 0, 150, 20 ), flags, font ).contains(
+				QLatin1String( "..." ) ) );
+
+		// Unique text on each call, so nothing is taken from the cache.
+		QBENCHMARK {
+			++i;
+
+			foreach( const QString & text, texts )
+				QtMWidgets::accomodateString( text + QString::number( i ),
+					QRect( 0, 0, 100 + i % 100, 20 ), flags, font );
+		}
+	}
+
+	void benchmarkElideStringLinear()
+	{
+		const QStringList texts = longTexts();
+		const QFontMetrics fm( ( QFont() ) );
+		const int flags = Qt::AlignLeft | Qt::AlignVCenter;
+		int i = 0;
+
+		QBENCHMARK {
+			++i;
+
+			foreach( const QString & text, texts )
+				linearElide( text + QString::number( i ),
+					QRect( 0, 0, 100 + i % 100, 20 ), flags, fm );
+		}
+	}
+
 	void testThreeItems()
 	{
 		QStringList data;
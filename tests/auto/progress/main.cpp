@@ -9,11 +9,34 @@
 #include <QtTest/QtTest>
 #include <QSharedPointer>
 #include <QVBoxLayout>
+#include <QThread>
+#include <QPaintEvent>
 
 // QtMWidgets include.
 #include <QtMWidgets/ProgressBar>
 
 
+//
+// PaintRecorder
+//
+
+//! Collects regions of paint events.
+class PaintRecorder
+	:	public QObject
+{
+public:
+	bool eventFilter( QObject * o, QEvent * e ) override
+	{
+		if( e->type() == QEvent::Paint )
+			regions.append( static_cast< QPaintEvent* > ( e )->region() );
+
+		return QObject::eventFilter( o, e );
+	}
+
+	QVector< QRegion > regions;
+}; // class PaintRecorder
+
+
 class TestProgress
 	:	public QObject
 {
@@ -133,6 +156,95 @@ private slots:
 		QVERIFY( p.grooveHeight() == 10 );
 		QVERIFY( p.highlightColor() == Qt::green );
 	}
+
+	void testPostValue()
+	{
+		enum { Maximum = 100000 };
+
+		QtMWidgets::ProgressBar p;
+		p.setRange( 0, Maximum );
+		p.resize( 150, 10 );
+		p.show();
+
+		QVERIFY( QTest::qWaitForWindowExposed( &p ) );
+
+		QSignalSpy spy( &p, &QtMWidgets::ProgressBar::valueChanged );
+
+		QScopedPointer< QThread > worker( QThread::create( [&p] ()
+			{
+				for( int i = 1; i <= Maximum; ++i )
+					p.postValue( i );
+			} ) );
+
+		worker->start();
+
+		QTRY_VERIFY( p.value() == Maximum );
+
+		QVERIFY( worker->wait() );
+		QVERIFY( spy.count() < Maximum );
+	}
+
+	void testValueRepaint()
+	{
+		QtMWidgets::ProgressBar p;
+		p.setRange( 0, 100 );
+		p.setValue( 10 );
+		p.resize( 150, 10 );
+		p.show();
+
+		QVERIFY( QTest::qWaitForWindowExposed( &p ) );
+
+		QTest::qWait( 100 );
+
+		PaintRecorder recorder;
+		p.installEventFilter( &recorder );
+
+		p.setValue( 50 );
+
+		QTRY_VERIFY( !recorder.regions.isEmpty() );
+
+		QTest::qWait( 100 );
+
+		p.removeEventFilter( &recorder );
+
+		// Groove between offsets 15 and 75 with one pixel around.
+		const QRect segment( 14, 0, 63, p.height() );
+
+		foreach( const QRegion & region, recorder.regions )
+			QVERIFY( segment.contains( region.boundingRect() ) );
+	}
+
+	void testBusyRepaint()
+	{
+		QtMWidgets::ProgressBar p;
+		p.resize( 150, 10 );
+		p.show();
+
+		QVERIFY( QTest::qWaitForWindowExposed( &p ) );
+
+		QTest::qWait( 100 );
+
+		PaintRecorder recorder;
+		p.installEventFilter( &recorder );
+
+		QTRY_VERIFY( recorder.regions.size() >= 5 );
+
+		p.removeEventFilter( &recorder );
+
+		// Old and new positions of two dots drawn with the pen.
+		const int dot = p.grooveHeight() + 1;
+
+		foreach( const QRegion & region, recorder.regions )
+		{
+			int area = 0;
+
+			for( const QRect & r : region )
+				area += r.width() * r.height();
+
+			QVERIFY( area > 0 );
+			QVERIFY( area <= dot * dot * 4 );
+		}
+	}
 };
 
 
@@ -0,0 +1,241 @@
+
+/*
+	SPDX-FileCopyrightText: 2014-2024 Igor Mironchik <igor.mironchik@gmail.com>
+	SPDX-License-Identifier: MIT
+*/
+
+// Qt include.
+#include <QObject>
+#include <QtTest/QtTest>
+
+// QtMWidgets include.
+#include <QtMWidgets/ScrollArea>
+#include <QtMWidgets/TableView>
+#include <QtMWidgets/TextLabel>
+
+
+//
+// HeightForWidthWidget
+//
+
+//! Widget counting calls of heightForWidth().
+class HeightForWidthWidget
+	:	public QWidget
+{
+public:
+	HeightForWidthWidget()
+		:	lines( 10 )
+		,	count( 0 )
+	{
+		QSizePolicy sp( QSizePolicy::Preferred, QSizePolicy::Preferred );
+		sp.setHeightForWidth( true );
+		setSizePolicy( sp );
+	}
+
+	bool hasHeightForWidth() const override
+	{
+		return true;
+	}
+
+	int heightForWidth( int w ) const override
+	{
+		++count;
+
+		return lines * 2000 / qMax( w, 1 );
+	}
+
+	QSize sizeHint() const override
+	{
+		return QSize( 100, 100 );
+	}
+
+	//! Count of lines, height is proportional to it.
+	int lines;
+	mutable int count;
+}; // class HeightForWidthWidget
+
+
+//
+// DataSource
+//
+
+//! Data source counting measured rows.
+class DataSource
+	:	public QtMWidgets::TableViewDataSource
+{
+public:
+	enum { Sections = 2, Rows = 100 };
+
+	DataSource()
+		:	count( 0 )
+	{
+	}
+
+	int sectionsCount() const override
+	{
+		return Sections;
+	}
+
+	int rowsCount( int ) const override
+	{
+		return Rows;
+	}
+
+	void setupCell( QtMWidgets::TableViewCell * cell,
+		int section, int row ) override
+	{
+		cell->textLabel()->setText( QStringLiteral( "%1:%2" )
+			.arg( section ).arg( row ) );
+	}
+
+	int rowHeight( int, int ) const override
+	{
+		++count;
+
+		return 44;
+	}
+
+	mutable int count;
+}; // class DataSource
+
+
+//
+// ResizeCounter
+//
+
+class ResizeCounter
+	:	public QObject
+{
+public:
+	ResizeCounter()
+		:	count( 0 )
+	{
+	}
+
+	bool eventFilter( QObject * o, QEvent * e ) override
+	{
+		if( e->type() == QEvent::Resize )
+			++count;
+
+		return QObject::eventFilter( o, e );
+	}
+
+	int count;
+}; // class ResizeCounter
+
+
+class TestScrollArea
+	:	public QObject
+{
+	Q_OBJECT
+
+private slots:
+
+	void testScrolledSizeFollowsContent()
+	{
+		QtMWidgets::ScrollArea area;
+		area.setWidgetResizable( true );
+
+		QtMWidgets::TextLabel * label = new QtMWidgets::TextLabel;
+		label->setText( QLatin1String( "Text" ) );
+		area.setWidget( label );
+
+		area.resize( 200, 200 );
+		area.show();
+
+		QVERIFY( QTest::qWaitForWindowExposed( &area ) );
+
+		QVERIFY( label->height() == area.viewport()->height() );
+
+		QString text;
+
+		for( int i = 0; i < 100; ++i )
+			text.append( QLatin1String( "Some long text to wrap. " ) );
+
+		label->setText( text );
+
+		QTRY_VERIFY( label->height() > area.viewport()->height() );
+		QVERIFY( area.scrolledAreaSize() == label->size() );
+
+		label->setText( QLatin1String( "Text" ) );
+
+		QTRY_VERIFY( label->height() == area.viewport()->height() );
+	}
+
+	void testLayoutRequestsUpdateOnce()
+	{
+		QtMWidgets::ScrollArea area;
+		area.setWidgetResizable( true );
+
+		HeightForWidthWidget * widget = new HeightForWidthWidget;
+		area.setWidget( widget );
+
+		area.resize( 200, 200 );
+		area.show();
+
+		QVERIFY( QTest::qWaitForWindowExposed( &area ) );
+
+		QCoreApplication::processEvents();
+
+		ResizeCounter resizes;
+		widget->installEventFilter( &resizes );
+		widget->count = 0;
+
+		widget->lines = 100;
+
+		// Several requests in one event loop iteration.
+		for( int i = 0; i < 3; ++i )
+		{
+			QEvent request( QEvent::LayoutRequest );
+			QCoreApplication::sendEvent( area.viewport(), &request );
+		}
+
+		QVERIFY( widget->count == 0 );
+		QVERIFY( resizes.count == 0 );
+
+		QCoreApplication::processEvents();
+
+		QVERIFY( widget->count == 1 );
+		QVERIFY( resizes.count == 1 );
+		QVERIFY( widget->height() > area.viewport()->height() );
+		QVERIFY( area.scrolledAreaSize() == widget->size() );
+	}
+
+	void testTableViewWidthChange()
+	{
+		QWidget parent;
+		parent.resize( 400, 400 );
+
+		DataSource source;
+
+		QtMWidgets::TableView * view = new QtMWidgets::TableView( &parent );
+		view->resize( 200, 400 );
+		view->setDataSource( &source );
+
+		parent.show();
+
+		QVERIFY( QTest::qWaitForWindowExposed( &parent ) );
+
+		QCoreApplication::processEvents();
+
+		ResizeCounter resizes;
+		view->widget()->installEventFilter( &resizes );
+		source.count = 0;
+
+		// Child is resized synchronously.
+		view->resize( 300, 400 );
+
+		QCoreApplication::processEvents();
+
+		// Rows are measured once for the new width.
+		QVERIFY( source.count == DataSource::Sections * DataSource::Rows );
+		QVERIFY( resizes.count == 1 );
+		QVERIFY( view->widget()->width() == view->viewport()->width() );
+		QVERIFY( view->scrolledAreaSize() == view->widget()->size() );
+	}
+};
+
+
+QTEST_MAIN( TestScrollArea )
+
+#include "main.moc"
@@ -11,6 +11,7 @@
 
 // QtMWidgets include.
 #include <QtMWidgets/Stepper>
+#include <QtMWidgets/VirtualClock>
 
 
 class TestStepper
@@ -107,6 +108,53 @@ private slots:
 		QVERIFY( spy.count() == 18 );
 	}
 
+	void testAutorepeat()
+	{
+		QtMWidgets::Stepper stepper;
+		stepper.setMinimum( 0 );
+		stepper.setMaximum( 100 );
+		stepper.setAutorepeat( true );
+
+		stepper.show();
+
+		QVERIFY( QTest::qWaitForWindowExposed( &stepper ) );
+
+		const QPoint plus( stepper.width() * 3 / 4, stepper.height() / 2 );
+
+		QtMWidgets::VirtualClock clock;
+		clock.activate();
+
+		QSignalSpy spy( &stepper, &QtMWidgets::Stepper::valueChanged );
+
+		QTest::mousePress( &stepper, Qt::LeftButton, {}, plus );
+
+		QVERIFY( stepper.value() == 1 );
+
+		// Five repeats with the default 500 ms timeout,
+		// the fifth one switches to the fast timeout.
+		for( int i = 0; i < 255; ++i )
+			clock.advanceBy( 10 );
+
+		QVERIFY( stepper.value() == 6 );
+
+		// Two repeats with the fast 250 ms timeout.
+		for( int i = 0; i < 50; ++i )
+			clock.advanceBy( 10 );
+
+		QVERIFY( stepper.value() == 8 );
+
+		QTest::mouseRelease( &stepper, Qt::LeftButton, {}, plus );
+
+		QVERIFY( stepper.value() == 8 );
+
+		clock.advanceBy( 1000 );
+
+		QVERIFY( stepper.value() == 8 );
+		QVERIFY( spy.count() == 8 );
+
+		clock.deactivate();
+	}
+
 private:
 	QSharedPointer< QtMWidgets::Stepper > m_stepper;
 	QPoint p1;
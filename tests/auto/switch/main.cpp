@@ -108,6 +108,28 @@ private slots:
 		QVERIFY( m_switch->isChecked() == false );
 	}
 
+	void testPaletteChange()
+	{
+		QPalette palette = m_switch->palette();
+		palette.setColor( QPalette::Base, Qt::red );
+
+		QtMWidgets::Switch s1;
+		s1.setOffText( QStringLiteral( "OFF" ) );
+
+		const QImage before = s1.grab().toImage();
+
+		s1.setPalette( palette );
+
+		QtMWidgets::Switch s2;
+		s2.setOffText( QStringLiteral( "OFF" ) );
+		s2.setPalette( palette );
+
+		const QImage after = s1.grab().toImage();
+
+		QVERIFY( after != before );
+		QVERIFY( after == s2.grab().toImage() );
+	}
+
 private:
 	QSharedPointer< QtMWidgets::Switch > m_switch;
 	QFont m_font;
@@ -17,6 +17,94 @@
 #include <QtMWidgets/Switch>
 
 
+//
+// DataSource
+//
+
+class DataSource
+	:	public QtMWidgets::TableViewDataSource
+{
+public:
+	enum { Sections = 3, Rows = 2000 };
+
+	int sectionsCount() const override
+	{
+		return Sections;
+	}
+
+	int rowsCount( int ) const override
+	{
+		return Rows;
+	}
+
+	void setupCell( QtMWidgets::TableViewCell * cell,
+		int section, int row ) override
+	{
+		cell->textLabel()->setText( QStringLiteral( "%1:%2" )
+			.arg( section ).arg( row ) );
+	}
+
+	QString headerText( int section ) const override
+	{
+		return QStringLiteral( "Section %1" ).arg( section );
+	}
+
+	int rowHeight( int, int ) const override
+	{
+		return 44;
+	}
+}; // class DataSource
+
+
+//
+// ResizeCounter
+//
+
+class ResizeCounter
+	:	public QObject
+{
+public:
+	ResizeCounter()
+		:	count( 0 )
+	{
+	}
+
+	bool eventFilter( QObject * o, QEvent * e ) override
+	{
+		if( e->type() == QEvent::Resize )
+			++count;
+
+		return QObject::eventFilter( o, e );
+	}
+
+	int count;
+}; // class ResizeCounter
+
+
+//
+// SizeHintCounter
+//
+
+class SizeHintCounter
+	:	public QWidget
+{
+public:
+	SizeHintCounter()
+		:	count( 0 )
+	{
+	}
+
+	QSize sizeHint() const override
+	{
+		++count;
+
+		return QSize( 10, 10 );
+	}
+
+	mutable int count;
+}; // class SizeHintCounter
+
+
 class TestTable
 	:	public QObject
 {
@@ -142,6 +230,241 @@ private slots:
 		QTest::qWait( 50 );
 	}
 
+	void testSectionLayout()
+	{
+		QtMWidgets::TableViewSection section;
+		section.header()->setText( QLatin1String( "Header" ) );
+		section.resize( 200, 400 );
+
+		for( int i = 0; i < 3; ++i )
+		{
+			QtMWidgets::TableViewCell * cell =
+				new QtMWidgets::TableViewCell( &section );
+			cell->textLabel()->setText( QString::number( i ) );
+			section.addCell( cell );
+		}
+
+		section.show();
+
+		QVERIFY( QTest::qWaitForWindowExposed( &section ) );
+
+		// Header, footer and cells, no separator widgets.
+		QVERIFY( section.findChildren< QWidget* >( QString(),
+			Qt::FindDirectChildrenOnly ).size() == 5 );
+
+		for( int i = 1; i < section.cellsCount(); ++i )
+			QVERIFY( section.cellAt( i )->y() ==
+				section.cellAt( i - 1 )->geometry().bottom() + 2 );
+
+		const QRect first = section.cellAt( 0 )->geometry();
+
+		QtMWidgets::TableViewCell * cell =
+			new QtMWidgets::TableViewCell( &section );
+		section.insertCell( 1, cell );
+
+		QTest::qWait( 50 );
+
+		QVERIFY( section.cellAt( 0 )->geometry() == first );
+		QVERIFY( cell->y() == first.bottom() + 2 );
+		QVERIFY( section.cellAt( 2 )->y() == cell->geometry().bottom() + 2 );
+
+		section.removeCell( cell );
+		delete cell;
+
+		QTest::qWait( 50 );
+
+		QVERIFY( section.cellAt( 1 )->y() == first.bottom() + 2 );
+	}
+
+	void testSectionLayoutMeasuresNewCellOnly()
+	{
+		QtMWidgets::TableViewSection section;
+		section.resize( 200, 400 );
+
+		QList< SizeHintCounter* > counters;
+
+		for( int i = 0; i < 20; ++i )
+		{
+			QtMWidgets::TableViewCell * cell =
+				new QtMWidgets::TableViewCell( &section );
+			cell->textLabel()->setText( QString::number( i ) );
+
+			SizeHintCounter * counter = new SizeHintCounter;
+			cell->setAccessoryWidget( counter );
+			counters.append( counter );
+
+			section.addCell( cell );
+		}
+
+		section.show();
+
+		QVERIFY( QTest::qWaitForWindowExposed( &section ) );
+
+		QTest::qWait( 50 );
+
+		foreach( SizeHintCounter * counter, counters )
+			counter->count = 0;
+
+		QtMWidgets::TableViewCell * cell =
+			new QtMWidgets::TableViewCell( &section );
+		section.addCell( cell );
+
+		QTest::qWait( 50 );
+
+		QVERIFY( cell->height() > 0 );
+		QVERIFY( cell->y() > section.cellAt( 19 )->geometry().bottom() );
+
+		// Existing cells are neither measured nor laid out again.
+		foreach( SizeHintCounter * counter, counters )
+			QVERIFY( counter->count == 0 );
+
+		// Changed cell is measured again.
+		section.cellAt( 5 )->textLabel()->setText(
+			QLatin1String( "Some long text to wrap in the cell, "
+				"it should take more than one line" ) );
+
+		QTest::qWait( 50 );
+
+		QVERIFY( counters.at( 5 )->count > 0 );
+		QVERIFY( counters.at( 4 )->count == 0 );
+	}
+
+	void testBatchUpdate()
+	{
+		QtMWidgets::TableView view;
+		view.resize( 200, 400 );
+		view.show();
+
+		QVERIFY( QTest::qWaitForWindowExposed( &view ) );
+
+		ResizeCounter counter;
+		view.widget()->installEventFilter( &counter );
+
+		{
+			QtMWidgets::TableViewBatchUpdate batch( &view );
+
+			QList< QtMWidgets::TableViewSection* > sections;
+
+			for( int i = 0; i < 10; ++i )
+			{
+				QtMWidgets::TableViewSection * section =
+					new QtMWidgets::TableViewSection;
+				section->header()->setText( QString::number( i ) );
+
+				QList< QtMWidgets::TableViewCell* > cells;
+
+				for( int j = 0; j < 50; ++j )
+				{
+					QtMWidgets::TableViewCell * cell = new QtMWidgets::TableViewCell;
+					cell->textLabel()->setText( QString::number( j ) );
+					cells.append( cell );
+				}
+
+				section->addCells( cells );
+				sections.append( section );
+			}
+
+			view.addSections( sections );
+
+			QVERIFY( counter.count == 0 );
+		}
+
+		QVERIFY( counter.count <= 1 );
+		QVERIFY( view.sectionsCount() == 10 );
+
+		QtMWidgets::TableViewSection * last = view.sectionAt( 9 );
+
+		QVERIFY( last->cellsCount() == 50 );
+		QVERIFY( view.widget()->height() >= last->geometry().bottom() );
+		QVERIFY( last->y() > view.sectionAt( 8 )->y() );
+	}
+
+	void testDataSource()
+	{
+		DataSource source;
+		QtMWidgets::TableView view;
+		view.resize( 200, 400 );
+
+		QtMWidgets::TableViewSection * section =
+			new QtMWidgets::TableViewSection( &view );
+		view.addSection( section );
+
+		view.setDataSource( &source );
+
+		view.show();
+
+		QVERIFY( QTest::qWaitForWindowActive( &view ) );
+
+		QVERIFY( view.dataSource() == &source );
+		QVERIFY( view.widget()->height() >
+			DataSource::Sections * DataSource::Rows * 44 );
+
+		const int cellsCount =
+			view.findChildren< QtMWidgets::TableViewCell* >().size();
+
+		QVERIFY( cellsCount < 30 );
+
+		QVERIFY( view.visibleCell( 0, 0 ) != 0 );
+		QVERIFY( view.visibleCell( 0, 0 )->textLabel()->text() ==
+			QStringLiteral( "0:0" ) );
+		QVERIFY( view.visibleCell( 2, DataSource::Rows - 1 ) == 0 );
+
+		QtMWidgets::TableViewCell * firstCell = view.visibleCell( 0, 0 );
+
+		QVERIFY( view.indexOfCell( firstCell ) == qMakePair( 0, 0 ) );
+		QVERIFY( view.indexOfCell( 0 ) == qMakePair( -1, -1 ) );
+
+		view.ensureVisible( 0, view.widget()->height() - 1, 0, 0 );
+
+		QTest::qWait( 50 );
+
+		// Cell is reused for other row or returned to the pool.
+		const QPair< int, int > index = view.indexOfCell( firstCell );
+
+		QVERIFY( index != qMakePair( 0, 0 ) );
+
+		if( firstCell->isHidden() )
+			QVERIFY( index == qMakePair( -1, -1 ) );
+		else
+			QVERIFY( view.visibleCell( index.first, index.second ) == firstCell );
+
+		QVERIFY( view.indexOfCell( view.visibleCell( 2, DataSource::Rows - 1 ) ) ==
+			qMakePair( 2, DataSource::Rows - 1 ) );
+
+		QVERIFY( view.visibleCell( 0, 0 ) == 0 );
+		QVERIFY( view.visibleCell( 2, DataSource::Rows - 1 ) != 0 );
+		QVERIFY( view.visibleCell( 2, DataSource::Rows - 1 )->textLabel()->text() ==
+			QStringLiteral( "2:1999" ) );
+		QVERIFY( view.findChildren< QtMWidgets::TableViewCell* >().size() <=
+			cellsCount + 1 );
+
+		view.setDataSource( 0 );
+
+		QVERIFY( view.widget()->isAncestorOf( section ) );
+		QVERIFY( view.sectionsCount() == 1 );
+	}
+
+	void testDataSourceViewportGrows()
+	{
+		DataSource source;
+		QtMWidgets::TableView view;
+		view.setDataSource( &source );
+		view.resize( 200, 200 );
+
+		view.show();
+
+		QVERIFY( QTest::qWaitForWindowExposed( &view ) );
+
+		QVERIFY( view.visibleCell( 0, 0 ) != 0 );
+		QVERIFY( view.visibleCell( 0, 10 ) == 0 );
+
+		view.resize( 200, 800 );
+
+		QTRY_VERIFY( view.visibleCell( 0, 10 ) != 0 );
+		QVERIFY( view.visibleCell( 0, 10 )->textLabel()->text() ==
+			QStringLiteral( "0:10" ) );
+	}
+
 private:
 	QSharedPointer< QtMWidgets::TableView > m_v;
 	QtMWidgets::TableViewSection * m_ringerAndAlerts;
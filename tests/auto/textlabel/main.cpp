@@ -0,0 +1,361 @@
+
+/*
+	SPDX-FileCopyrightText: 2014-2024 Igor Mironchik <igor.mironchik@gmail.com>
+	SPDX-License-Identifier: MIT
+*/
+
+// Qt include.
+#include <QObject>
+#include <QtTest/QtTest>
+#include <QImage>
+
+// QtMWidgets include.
+#include <QtMWidgets/TextLabel>
+#include <QtMWidgets/private/textlabel_p.hpp>
+
+
+//
+// longText
+//
+
+static QString
+longText( const QString & word )
+{
+	enum { Lines = 20000 };
+
+	QString text;
+
+	for( int i = 0; i < Lines; ++i )
+	{
+		if( i > 0 )
+			text.append( QLatin1Char( '\n' ) );
+
+		text.append( QStringLiteral( "%1 %2 with some words to wrap" )
+			.arg( word ).arg( i ) );
+	}
+
+	return text;
+}
+
+
+//
+// hasText
+//
+
+//! \return Is something drawn over the background in the \a rect of the image?
+static bool
+hasText( const QImage & image, const QRect & rect = QRect() )
+{
+	const QRgb background = image.pixel( 0, 0 );
+	const QRect r = ( rect.isNull() ? image.rect() : rect );
+
+	for( int y = r.top(); y <= r.bottom(); ++y )
+	{
+		for( int x = r.left(); x <= r.right(); ++x )
+		{
+			if( image.pixel( x, y ) != background )
+				return true;
+		}
+	}
+
+	return false;
+}
+
+
+//
+// LayoutRequestCounter
+//
+
+class LayoutRequestCounter
+	:	public QObject
+{
+public:
+	LayoutRequestCounter()
+		:	count( 0 )
+	{
+	}
+
+	bool eventFilter( QObject * o, QEvent * e ) override
+	{
+		if( e->type() == QEvent::LayoutRequest )
+			++count;
+
+		return QObject::eventFilter( o, e );
+	}
+
+	int count;
+}; // class LayoutRequestCounter
+
+
+class TestTextLabel
+	:	public QObject
+{
+	Q_OBJECT
+
+private slots:
+
+	void testAsyncStaleResultDropped()
+	{
+		QtMWidgets::TextLabel label;
+		label.setAsyncLayout( true );
+		label.setText( longText( QLatin1String( "Line" ) ) );
+
+		// Starts layout of the long text.
+		label.heightForWidth( 200 );
+
+		label.setText( QLatin1String( "Short" ) );
+
+		label.heightForWidth( 200 );
+
+		QTRY_VERIFY( label.heightForWidth( 200 ) < 100 );
+
+		QTest::qWait( 200 );
+
+		// Result for the long text never replaces the short one.
+		QVERIFY( label.heightForWidth( 200 ) < 100 );
+	}
+
+	void testAsyncEstimatedHeight()
+	{
+		QWidget parent;
+		parent.resize( 300, 300 );
+
+		QtMWidgets::TextLabel * label = new QtMWidgets::TextLabel( &parent );
+		label->setAsyncLayout( true );
+		label->resize( 200, 100 );
+
+		LayoutRequestCounter counter;
+		parent.installEventFilter( &counter );
+
+		parent.show();
+
+		QVERIFY( QTest::qWaitForWindowExposed( &parent ) );
+
+		label->setText( longText( QLatin1String( "Line" ) ) );
+
+		const int estimated = label->heightForWidth( 200 );
+
+		QVERIFY( estimated > 0 );
+
+		// Drop the request of setText().
+		QCoreApplication::sendPostedEvents( &parent, QEvent::LayoutRequest );
+		counter.count = 0;
+
+		// Real height arrives with updateGeometry().
+		QTRY_VERIFY( counter.count > 0 );
+
+		const int height = label->heightForWidth( 200 );
+
+		QVERIFY( height != estimated );
+		QVERIFY( height > 10000 * label->fontMetrics().height() );
+	}
+
+	void testAsyncPaintBeforeResult()
+	{
+		QtMWidgets::TextLabel label;
+		label.setAsyncLayout( true );
+		label.setMargin( 10 );
+		label.resize( 200, 100 );
+
+		label.setText( longText( QLatin1String( "Line" ) ) );
+
+		// Nothing is laid out yet, nothing is drawn.
+		QImage image = label.grab().toImage();
+
+		QVERIFY( image.size() == label.size() * label.devicePixelRatioF() );
+		QVERIFY( !hasText( image ) );
+
+		label.heightForWidth( 200 );
+
+		QTRY_VERIFY( hasText( label.grab().toImage() ) );
+
+		label.setText( longText( QLatin1String( "Row" ) ) );
+
+		// Previous layout is shown until the new one is ready.
+		image = label.grab().toImage();
+
+		QVERIFY( hasText( image ) );
+
+		QTest::qWait( 200 );
+	}
+
+	void testAsyncProbeKeepsLayout()
+	{
+		QtMWidgets::TextLabel label;
+		label.setAsyncLayout( true );
+		label.resize( 200, 100 );
+
+		label.setText( longText( QLatin1String( "Line" ) ) );
+
+		const QtMWidgets::TextLabelPrivate * d =
+			QtMWidgets::TextLabelPrivate::get( &label );
+
+		// Starts layout for the label's width.
+		label.grab();
+
+		// Probe of other width doesn't cancel it.
+		label.heightForWidth( 300 );
+
+		QTRY_VERIFY( hasText( label.grab().toImage() ) );
+		QTRY_VERIFY( d->heights.contains( 300 ) );
+
+		// Probe's layout is never shown.
+		QVERIFY( d->layout.width == 200 );
+	}
+
+	void testPlainAndRichTextHeights()
+	{
+		QFont font;
+		font.setPointSize( 20 );
+
+		const QString text = QLatin1String( "Some words that should be "
+			"wrapped into several lines in the label" );
+
+		QtMWidgets::TextLabel plain;
+		plain.setFont( font );
+		plain.setTextFormat( Qt::PlainText );
+		plain.setText( text );
+
+		QtMWidgets::TextLabel rich;
+		rich.setFont( font );
+		rich.setTextFormat( Qt::RichText );
+		rich.setText( text );
+
+		QVERIFY( plain.heightForWidth( 200 ) > QFontMetrics( font ).height() * 2 );
+		QVERIFY( plain.heightForWidth( 200 ) == rich.heightForWidth( 200 ) );
+		QVERIFY( plain.minimumSizeHint() == rich.minimumSizeHint() );
+	}
+
+	void testVirtualizedHeight()
+	{
+		QString text;
+
+		for( int i = 0; i < 50; ++i )
+		{
+			if( i > 0 )
+				text.append( i % 5 ? QLatin1String( "\n" ) : QLatin1String( "\n\n" ) );
+
+			text.append( QStringLiteral( "Paragraph %1 with words that "
+				"should be wrapped into several lines" ).arg( i ) );
+		}
+
+		QtMWidgets::TextLabel label;
+		label.setText( text );
+
+		QtMWidgets::TextLabel virtualized;
+		virtualized.setVirtualizedParagraphs( true );
+		virtualized.setText( text );
+
+		for( int w = 100; w <= 400; w += 100 )
+			QVERIFY( virtualized.heightForWidth( w ) == label.heightForWidth( w ) );
+	}
+
+	void testVirtualizedPaintsVisibleParagraphs()
+	{
+		enum { Paragraphs = 1000 };
+
+		QString text;
+
+		for( int i = 0; i < Paragraphs; ++i )
+		{
+			if( i > 0 )
+				text.append( QLatin1Char( '\n' ) );
+
+			text.append( QStringLiteral( "Paragraph %1" ).arg( i ) );
+		}
+
+		QtMWidgets::TextLabel label;
+		label.setVirtualizedParagraphs( true );
+		label.setText( text );
+		label.resize( 200, label.heightForWidth( 200 ) );
+
+		const QtMWidgets::TextLabelPrivate * d =
+			QtMWidgets::TextLabelPrivate::get( &label );
+
+		const int lineHeight = label.fontMetrics().height();
+		QImage image( 200, lineHeight, QImage::Format_ARGB32_Premultiplied );
+		image.fill( Qt::white );
+
+		label.render( &image, QPoint(), QRegion( 0, 0, 200, lineHeight ) );
+
+		QVERIFY( d->layout.paragraphStarts.size() == Paragraphs );
+		QVERIFY( d->paragraphLayouts.size() > 0 );
+		QVERIFY( d->paragraphLayouts.size() <= 2 );
+		QVERIFY( hasText( image ) );
+
+		const int y = label.height() / 2;
+
+		label.render( &image, QPoint(), QRegion( 0, y, 200, lineHeight ) );
+
+		QVERIFY( d->paragraphLayouts.size() <= 4 );
+	}
+
+	void testVirtualizedLongParagraph()
+	{
+		QString text;
+
+		for( int i = 0; i < 3000; ++i )
+			text.append( QStringLiteral( "word%1 " ).arg( i ) );
+
+		QtMWidgets::TextLabel label;
+		label.setText( text );
+
+		QtMWidgets::TextLabel virtualized;
+		virtualized.setVirtualizedParagraphs( true );
+		virtualized.setText( text );
+
+		QVERIFY( virtualized.heightForWidth( 200 ) == label.heightForWidth( 200 ) );
+
+		virtualized.resize( 200, virtualized.heightForWidth( 200 ) );
+
+		const QtMWidgets::TextLabelPrivate * d =
+			QtMWidgets::TextLabelPrivate::get( &virtualized );
+
+		// Single paragraph is split into blocks.
+		QVERIFY( d->layout.paragraphStarts.size() > 1 );
+
+		const int lineHeight = virtualized.fontMetrics().height();
+		QImage image( 200, lineHeight, QImage::Format_ARGB32_Premultiplied );
+		image.fill( Qt::white );
+
+		virtualized.render( &image, QPoint(),
+			QRegion( 0, virtualized.height() / 2, 200, lineHeight ) );
+
+		QVERIFY( hasText( image ) );
+		QVERIFY( d->paragraphLayouts.size() <= 2 );
+	}
+
+	void testVirtualizedAlignment()
+	{
+		QtMWidgets::TextLabel label;
+		label.setVirtualizedParagraphs( true );
+
+		QTextOption opt = label.textOption();
+		opt.setAlignment( Qt::AlignRight );
+		label.setTextOption( opt );
+
+		label.setText( QLatin1String( "Right\nAligned\n" ) );
+
+		QtMWidgets::TextLabel withoutTrailing;
+		withoutTrailing.setVirtualizedParagraphs( true );
+		withoutTrailing.setText( QLatin1String( "Right\nAligned" ) );
+
+		// Trailing new line is an empty paragraph.
+		QVERIFY( label.heightForWidth( 300 ) > withoutTrailing.heightForWidth( 300 ) );
+
+		label.resize( 300, label.heightForWidth( 300 ) );
+
+		QImage image( label.size(), QImage::Format_ARGB32_Premultiplied );
+		image.fill( Qt::white );
+
+		label.render( &image );
+
+		QVERIFY( !hasText( image, QRect( 0, 0, 100, image.height() ) ) );
+		QVERIFY( hasText( image, QRect( 200, 0, 100, image.height() ) ) );
+	}
+};
+
+
+QTEST_MAIN( TestTextLabel )
+
+#include "main.moc"